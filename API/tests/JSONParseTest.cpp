@@ -31,6 +31,7 @@
 #include "JSONObject.h"
 #include "VM.h"
 #include <wtf/RefPtr.h>
+#include <wtf/text/StringBuilder.h>
 
 using namespace JSC;
 
@@ -58,6 +59,34 @@ int testJSONParse()
     failed = failed || (v3 != v4);
     failed = failed || (v4 == v5);
 
+    // The first "a" is overwritten, so the {"x","y"} Structure it was cached from is only held by
+    // the parser's shape cache. Collecting on every slow path allocation while the strings in the
+    // middle are parsed must not free that Structure before the last object uses it.
+    {
+        StringBuilder builder;
+        builder.appendLiteral("[{\"a\":{\"x\":1,\"y\":2},\"a\":0}");
+        for (unsigned i = 0; i < 2000; ++i) {
+            builder.appendLiteral(",\"string");
+            builder.appendNumber(i);
+            builder.append('"');
+        }
+        builder.appendLiteral(",{\"x\":3,\"y\":4}]");
+
+        unsigned oldSlowPathAllocsBetweenGCs = Options::slowPathAllocsBetweenGCs();
+        Options::slowPathAllocsBetweenGCs() = 1;
+        JSValue result = JSONParse(exec, builder.toString());
+        Options::slowPathAllocsBetweenGCs() = oldSlowPathAllocsBetweenGCs;
+
+        JSObject* array = result.getObject();
+        failed = failed || !array;
+        if (array) {
+            JSObject* last = array->get(exec, 2001).getObject();
+            failed = failed || !last;
+            failed = failed || (last && last->get(exec, Identifier::fromString(exec, "x")) != jsNumber(3));
+            failed = failed || (last && last->get(exec, Identifier::fromString(exec, "y")) != jsNumber(4));
+        }
+    }
+
     vm = nullptr;
 
     if (failed)
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2018 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmSIMDTest.h"
+
+#include "JavaScript.h"
+#include <stdio.h>
+
+// The module exports:
+// a(x, y) = i32x4.extract_lane 2 (i32x4.add (i32x4.splat x) (i32x4.splat y))
+// b(x, y) = i8x16.extract_lane_s 5 (i8x16.add_sat_s (i8x16.splat x) (i8x16.splat y))
+// c(x) = i32x4.extract_lane 3 (i32x4.mul v v), where v is a v128 local set to (i32x4.splat x)
+static const char* simdScript =
+    "(function() {"
+    "    if (typeof WebAssembly === 'undefined')"
+    "        return true;"
+    "    const bytes = new Uint8Array(["
+    "        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0c, 0x02, 0x60, 0x02, 0x7f, 0x7f, 0x01,"
+    "        0x7f, 0x60, 0x01, 0x7f, 0x01, 0x7f, 0x03, 0x04, 0x03, 0x00, 0x00, 0x01, 0x07, 0x0d, 0x03, 0x01,"
+    "        0x61, 0x00, 0x00, 0x01, 0x62, 0x00, 0x01, 0x01, 0x63, 0x00, 0x02, 0x0a, 0x37, 0x03, 0x10, 0x00,"
+    "        0x20, 0x00, 0xfd, 0x11, 0x20, 0x01, 0xfd, 0x11, 0xfd, 0xae, 0x01, 0xfd, 0x1b, 0x02, 0x0b, 0x0f,"
+    "        0x00, 0x20, 0x00, 0xfd, 0x0f, 0x20, 0x01, 0xfd, 0x0f, 0xfd, 0x6f, 0xfd, 0x15, 0x05, 0x0b, 0x14,"
+    "        0x01, 0x01, 0x7b, 0x20, 0x00, 0xfd, 0x11, 0x21, 0x01, 0x20, 0x01, 0x20, 0x01, 0xfd, 0xb5, 0x01,"
+    "        0xfd, 0x1b, 0x03, 0x0b"
+    "    ]);"
+    "    const { a, b, c } = new WebAssembly.Instance(new WebAssembly.Module(bytes)).exports;"
+    "    for (let i = 0; i < 1e4; ++i) {"
+    "        if (a(i, 3) !== ((i + 3) | 0))"
+    "            return false;"
+    "        if (b(100, 100) !== 127 || b(-100, -100) !== -128 || b(i & 0x3f, 1) !== (i & 0x3f) + 1)"
+    "            return false;"
+    "        if (c(i) !== Math.imul(i, i))"
+    "            return false;"
+    "    }"
+    "    return true;"
+    "})()";
+
+int testWasmSIMD()
+{
+    bool failed = false;
+
+    JSGlobalContextRef context = JSGlobalContextCreateInGroup(nullptr, nullptr);
+    JSStringRef script = JSStringCreateWithUTF8CString(simdScript);
+    JSValueRef exception = nullptr;
+    JSValueRef result = JSEvaluateScript(context, script, nullptr, nullptr, 1, &exception);
+    failed = exception || !JSValueIsBoolean(context, result) || !JSValueToBoolean(context, result);
+    JSStringRelease(script);
+    JSGlobalContextRelease(context);
+
+    if (failed)
+        printf("FAIL: WebAssembly SIMD test.\n");
+    else
+        printf("PASS: WebAssembly SIMD test.\n");
+
+    return failed;
+}
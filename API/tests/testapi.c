@@ -61,6 +61,7 @@
 #include "MultithreadedMultiVMExecutionTest.h"
 #include "PingPongStackOverflowTest.h"
 #include "TypedArrayCTest.h"
+#include "WasmSIMDTest.h"
 
 #if JSC_OBJC_API_ENABLED
 void testObjectiveCAPI(void);
@@ -2063,6 +2064,7 @@ int main(int argc, char* argv[])
     failed = testPingPongStackOverflow() || failed;
     failed = testJSONParse() || failed;
     failed = testJSObjectGetProxyTarget() || failed;
+    failed = testWasmSIMD() || failed;
 
     // Clear out local variables pointing at JSObjectRefs to allow their values to be collected
     function = NULL;
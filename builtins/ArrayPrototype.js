@@ -600,11 +600,13 @@ function sort(comparator)
     if (length < 2)
         return array;
 
-    if (typeof comparator == "function")
-        comparatorSort(array, length, comparator);
-    else if (comparator === @undefined)
-        stringSort(array, length);
-    else
+    if (typeof comparator == "function") {
+        if (!@arraySortFastPath(array, comparator))
+            comparatorSort(array, length, comparator);
+    } else if (comparator === @undefined) {
+        if (!@arraySortFastPath(array, @undefined))
+            stringSort(array, length);
+    } else
         @throwTypeError("Array.prototype.sort requires the comparsion function be a function or undefined");
 
     return array;
@@ -47,12 +47,19 @@ function asyncFunctionResume(generator, promiseCapability, sentValue, resumeMode
         return promiseCapability.@promise;
     }
 
-    let wrappedValue = @newPromiseCapability(@Promise);
-    wrappedValue.@resolve.@call(@undefined, value);
+    // Awaiting a native promise reuses it instead of wrapping it in a new one, and the
+    // reaction has no derived promise of its own.
+    let promise;
+    try {
+        promise = @promiseResolve(@Promise, value);
+    } catch (error) {
+        return @asyncFunctionResume(generator, promiseCapability, error, @GeneratorResumeModeThrow);
+    }
 
-    wrappedValue.@promise.@then(
+    @performPromiseThen(promise,
         function(value) { @asyncFunctionResume(generator, promiseCapability, value, @GeneratorResumeModeNormal); },
-        function(error) { @asyncFunctionResume(generator, promiseCapability, error, @GeneratorResumeModeThrow); });
+        function(error) { @asyncFunctionResume(generator, promiseCapability, error, @GeneratorResumeModeThrow); },
+        @undefined);
 
     return promiseCapability.@promise;
 }
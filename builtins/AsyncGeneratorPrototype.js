@@ -152,14 +152,17 @@ function awaitValue(generator, value, onFullfiled)
 {
     "use strict";
 
-    const wrappedValue = @newPromiseCapability(@Promise);
-
     const onRejected = function (result) { @doAsyncGeneratorBodyCall(generator, result, @GeneratorResumeModeThrow); };
 
-    wrappedValue.@resolve.@call(@undefined, value);
-    wrappedValue.@promise.@then(onFullfiled, onRejected);
+    let promise;
+    try {
+        promise = @promiseResolve(@Promise, value);
+    } catch (error) {
+        @doAsyncGeneratorBodyCall(generator, error, @GeneratorResumeModeThrow);
+        return;
+    }
 
-    return wrappedValue;
+    @performPromiseThen(promise, onFullfiled, onRejected, @undefined);
 }
 
 @globalPrivate
@@ -147,6 +147,8 @@ namespace JSC {
     macro(isConstructor) \
     macro(concatMemcpy) \
     macro(appendMemcpy) \
+    macro(arraySortFastPath) \
+    macro(copyDataPropertiesByCloningStructure) \
     macro(regExpCreate) \
     macro(replaceUsingRegExp) \
     macro(replaceUsingStringSearch) \
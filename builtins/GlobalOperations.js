@@ -122,6 +122,9 @@ function copyDataPropertiesNoExclusions(target, source)
     if (source == null) 
         return target;
 
+    if (@isObject(source) && @copyDataPropertiesByCloningStructure(target, source))
+        return target;
+
     let from = @toObject(source);
     let keys = @Reflect.@ownKeys(from); 
     let keysLength = keys.length;
@@ -117,15 +117,5 @@ function resolve(value)
     if (!@isObject(this))
         @throwTypeError("|this| is not a object");
 
-    if (@isPromise(value)) {
-        var valueConstructor = value.constructor;
-        if (valueConstructor === this)
-            return value;
-    }
-
-    var promiseCapability = @newPromiseCapability(this);
-
-    promiseCapability.@resolve.@call(@undefined, value);
-
-    return promiseCapability.@promise;
+    return @promiseResolve(this, value);
 }
@@ -84,6 +84,41 @@ function newPromiseCapability(constructor)
     return promiseCapability;
 }
 
+@globalPrivate
+function promiseResolve(constructor, value)
+{
+    "use strict";
+
+    if (@isPromise(value) && value.constructor === constructor)
+        return value;
+
+    var promiseCapability = @newPromiseCapability(constructor);
+
+    promiseCapability.@resolve.@call(@undefined, value);
+
+    return promiseCapability.@promise;
+}
+
+@globalPrivate
+function performPromiseThen(promise, onFulfilled, onRejected, resultCapability)
+{
+    "use strict";
+
+    var reaction = @newPromiseReaction(resultCapability, onFulfilled, onRejected);
+
+    var state = @getByIdDirectPrivate(promise, "promiseState");
+    if (state === @promiseStatePending) {
+        var reactions = @getByIdDirectPrivate(promise, "promiseReactions");
+        @putByValDirect(reactions, reactions.length, reaction);
+    } else {
+        if (state === @promiseStateRejected && !@getByIdDirectPrivate(promise, "promiseIsHandled"))
+            @hostPromiseRejectionTracker(promise, @promiseRejectionHandle);
+        @enqueueJob(@promiseReactionJob, state, reaction, @getByIdDirectPrivate(promise, "promiseResult"));
+    }
+
+    @putByIdDirectPrivate(promise, "promiseIsHandled", true);
+}
+
 @globalPrivate
 function newHandledRejectedPromise(error)
 {
@@ -99,7 +134,7 @@ function triggerPromiseReactions(state, reactions, argument)
     "use strict";
 
     for (var index = 0, length = reactions.length; index < length; ++index)
-        @enqueueJob(@promiseReactionJob, [state, reactions[index], argument]);
+        @enqueueJob(@promiseReactionJob, state, reactions[index], argument);
 }
 
 @globalPrivate
@@ -163,7 +198,7 @@ function createResolvingFunctions(promise)
         if (typeof then !== 'function')
             return @fulfillPromise(promise, resolution);
 
-        @enqueueJob(@promiseResolveThenableJob, [promise, resolution, then]);
+        @enqueueJob(@promiseResolveThenableJob, promise, resolution, then);
 
         return @undefined;
     }
@@ -188,6 +223,11 @@ function promiseReactionJob(state, reaction, argument)
 
     var result;
     var handler = (state === @promiseStateFulfilled) ? reaction.@onFulfilled: reaction.@onRejected;
+
+    // Internal reactions, such as the ones await uses, have no derived promise to settle.
+    if (promiseCapability === @undefined)
+        return handler(argument);
+
     try {
         result = handler(argument);
     } catch (error) {
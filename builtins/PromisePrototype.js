@@ -47,19 +47,7 @@ function then(onFulfilled, onRejected)
     if (typeof onRejected !== "function")
         onRejected = function (argument) { throw argument; };
 
-    var reaction = @newPromiseReaction(resultCapability, onFulfilled, onRejected);
-
-    var state = @getByIdDirectPrivate(this, "promiseState");
-    if (state === @promiseStatePending) {
-        var reactions = @getByIdDirectPrivate(this, "promiseReactions");
-        @putByValDirect(reactions, reactions.length, reaction);
-    } else {
-        if (state === @promiseStateRejected && !@getByIdDirectPrivate(this, "promiseIsHandled"))
-            @hostPromiseRejectionTracker(this, @promiseRejectionHandle);
-        @enqueueJob(@promiseReactionJob, [state, reaction, @getByIdDirectPrivate(this, "promiseResult")]);
-    }
-
-    @putByIdDirectPrivate(this, "promiseIsHandled", true);
+    @performPromiseThen(this, onFulfilled, onRejected, resultCapability);
 
     return resultCapability.@promise;
 }
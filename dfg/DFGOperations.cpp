@@ -70,6 +70,7 @@
 #include "Repatch.h"
 #include "ScopedArguments.h"
 #include "StringConstructor.h"
+#include "StringKernels.h"
 #include "SuperSampler.h"
 #include "Symbol.h"
 #include "TypeProfilerLog.h"
@@ -2036,7 +2037,7 @@ JSString* JIT_OPERATION operationToLowerCase(ExecState* exec, JSString* string,
     if (!inputString.length())
         return vm.smallStrings.emptyString();
 
-    String lowercasedString = inputString.is8Bit() ? inputString.convertToLowercaseWithoutLocaleStartingAtFailingIndex8Bit(failingIndex) : inputString.convertToLowercaseWithoutLocale();
+    String lowercasedString = StringKernels::convertCaseWithoutLocale<StringKernels::ASCIICaseConversion::ToLower>(inputString, failingIndex);
     if (lowercasedString.impl() == inputString.impl())
         return string;
     scope.release();
@@ -1604,7 +1604,6 @@ void Heap::stopThePeriphery(GCConductor conn)
     
     vm()->shadowChicken().update(*vm(), vm()->topCallFrame);
     
-    m_structureIDTable.flushOldTables();
     m_objectSpace.stopAllocating();
     
     m_stopTime = MonotonicTime::now();
@@ -2050,6 +2049,7 @@ void Heap::finalize()
 
     if (Options::logGC()) {
         MonotonicTime after = MonotonicTime::now();
+        dataLog("structure IDs: ", m_structureIDTable.liveIDCount(), " live, ", m_structureIDTable.freeIDCount(), " free, ", m_structureIDTable.releasedSegmentCount(), " segments released, ");
         dataLog((after - before).milliseconds(), "ms]\n");
     }
 }
@@ -69,6 +69,12 @@ public:
         set(other.get());
     }
     
+    Strong(Strong&& other)
+        : Handle<T>()
+    {
+        swap(other);
+    }
+
     enum HashTableDeletedValueTag { HashTableDeletedValue };
     bool isHashTableDeletedValue() const { return slot() == hashTableDeletedValue(); }
     Strong(HashTableDeletedValueTag)
@@ -116,6 +122,12 @@ public:
         return *this;
     }
 
+    Strong& operator=(Strong&& other)
+    {
+        Strong(WTFMove(other)).swap(*this);
+        return *this;
+    }
+
     void clear()
     {
         if (!slot())
@@ -781,6 +781,16 @@ JSValue Interpreter::executeProgram(const SourceCode& source, CallFrame* callFra
     EXCEPTION_ASSERT(throwScope.exception() || program);
     RETURN_IF_EXCEPTION(throwScope, { });
 
+    throwScope.release();
+    return executeProgram(program, callFrame, thisObj);
+}
+
+JSValue Interpreter::executeProgram(ProgramExecutable* program, CallFrame* callFrame, JSObject* thisObj)
+{
+    JSScope* scope = thisObj->globalObject()->globalScope();
+    VM& vm = *scope->vm();
+    auto throwScope = DECLARE_THROW_SCOPE(vm);
+
     throwScope.assertNoException();
     ASSERT(!vm.isCollectorBusyOnCurrentThread());
     RELEASE_ASSERT(vm.currentThreadIsHoldingAPILock());
@@ -49,15 +49,20 @@
 #include "JSModuleLoader.h"
 #include "JSNativeStdFunction.h"
 #include "JSONObject.h"
+#include "JSPromiseDeferred.h"
 #include "JSSourceCode.h"
 #include "JSString.h"
+#include "JSToWasm.h"
 #include "JSTypedArrays.h"
+#include "JSWebAssemblyCompileError.h"
+#include "JSWebAssemblyHelpers.h"
 #include "JSWebAssemblyInstance.h"
 #include "JSWebAssemblyMemory.h"
 #include "LLIntThunks.h"
 #include "ObjectConstructor.h"
 #include "ParserError.h"
 #include "ProfilerDatabase.h"
+#include "ProgramExecutable.h"
 #include "PromiseDeferredTimer.h"
 #include "ProtoCallFrame.h"
 #include "ReleaseHeapAccessScope.h"
@@ -68,9 +73,15 @@
 #include "SuperSampler.h"
 #include "TestRunnerUtils.h"
 #include "TypedArrayInlines.h"
+#include "WasmCodeBlock.h"
 #include "WasmContext.h"
 #include "WasmFaultSignalHandler.h"
 #include "WasmMemory.h"
+#include "WasmModule.h"
+#include "WasmNameSection.h"
+#include "WasmStreamingCompiler.h"
+#include "WasmToJS.h"
+#include "WebAssemblyPrototype.h"
 #include <locale.h>
 #include <math.h>
 #include <stdio.h>
@@ -202,13 +213,23 @@ static void checkException(ExecState*, GlobalObject*, bool isLastFile, bool hasE
 class Message : public ThreadSafeRefCounted<Message> {
 public:
     Message(ArrayBufferContents&&, int32_t);
+#if ENABLE(WEBASSEMBLY)
+    Message(Ref<Wasm::Memory>&&, int32_t);
+#endif
     ~Message();
     
     ArrayBufferContents&& releaseContents() { return WTFMove(m_contents); }
     int32_t index() const { return m_index; }
+#if ENABLE(WEBASSEMBLY)
+    // Set instead of the contents when a shared WebAssembly.Memory was broadcast.
+    Wasm::Memory* memory() const { return m_memory.get(); }
+#endif
 
 private:
     ArrayBufferContents m_contents;
+#if ENABLE(WEBASSEMBLY)
+    RefPtr<Wasm::Memory> m_memory;
+#endif
     int32_t m_index { 0 };
 };
 
@@ -278,6 +299,7 @@ static EncodedJSValue JSC_HOST_CALL functionLoad(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionLoadString(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionReadFile(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionCheckSyntax(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionLoadPrepared(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionReadline(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionPreciseTime(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionNeverInlineFunction(ExecState*);
@@ -320,6 +342,8 @@ static EncodedJSValue JSC_HOST_CALL functionAsyncTestPassed(ExecState*);
 
 #if ENABLE(WEBASSEMBLY)
 static EncodedJSValue JSC_HOST_CALL functionWebAssemblyMemoryMode(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionWebAssemblyTimeToCompile(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionWebAssemblyFunctionProfile(ExecState*);
 #endif
 
 #if ENABLE(SAMPLING_FLAGS)
@@ -500,6 +524,7 @@ protected:
         addFunction(vm, "readFile", functionReadFile, 2);
         addFunction(vm, "read", functionReadFile, 2);
         addFunction(vm, "checkSyntax", functionCheckSyntax, 1);
+        addFunction(vm, "loadPrepared", functionLoadPrepared, 1);
         addFunction(vm, "sleepSeconds", functionSleepSeconds, 1);
         addFunction(vm, "jscStack", functionJSCStack, 1);
         addFunction(vm, "readline", functionReadline, 0);
@@ -563,6 +588,8 @@ protected:
 
 #if ENABLE(WEBASSEMBLY)
         addFunction(vm, "WebAssemblyMemoryMode", functionWebAssemblyMemoryMode, 1);
+        addFunction(vm, "WebAssemblyTimeToCompile", functionWebAssemblyTimeToCompile, 4);
+        addFunction(vm, "WebAssemblyFunctionProfile", functionWebAssemblyFunctionProfile, 1);
 #endif
 
         if (!arguments.isEmpty()) {
@@ -625,6 +652,10 @@ protected:
     static Identifier moduleLoaderResolve(JSGlobalObject*, ExecState*, JSModuleLoader*, JSValue, JSValue, JSValue);
     static JSInternalPromise* moduleLoaderFetch(JSGlobalObject*, ExecState*, JSModuleLoader*, JSValue, JSValue, JSValue);
     static JSObject* moduleLoaderCreateImportMetaProperties(JSGlobalObject*, ExecState*, JSModuleLoader*, JSValue, JSModuleRecord*, JSValue);
+#if ENABLE(WEBASSEMBLY)
+    static void compileStreaming(JSGlobalObject*, ExecState*, JSPromiseDeferred*, JSValue);
+    static void instantiateStreaming(JSGlobalObject*, ExecState*, JSPromiseDeferred*, JSValue, JSObject*);
+#endif
 };
 
 static bool supportsRichSourceInfo = true;
@@ -647,8 +678,13 @@ const GlobalObjectMethodTable GlobalObject::s_globalObjectMethodTable = {
     nullptr, // moduleLoaderEvaluate
     nullptr, // promiseRejectionTracker
     nullptr, // defaultLanguage
+#if ENABLE(WEBASSEMBLY)
+    &compileStreaming,
+    &instantiateStreaming,
+#else
     nullptr, // compileStreaming
     nullptr, // instantinateStreaming
+#endif
 };
 
 GlobalObject::GlobalObject(VM& vm, Structure* structure)
@@ -1021,6 +1057,43 @@ JSObject* GlobalObject::moduleLoaderCreateImportMetaProperties(JSGlobalObject* g
     return metaProperties;
 }
 
+#if ENABLE(WEBASSEMBLY)
+// The shell has no Response, so its streaming hooks take a BufferSource, which arrives as a single chunk.
+static bool addStreamingSource(ExecState* exec, JSPromiseDeferred* promise, Wasm::StreamingCompiler& compiler, JSValue source)
+{
+    VM& vm = exec->vm();
+    auto scope = DECLARE_CATCH_SCOPE(vm);
+
+    const uint8_t* base;
+    size_t byteSize;
+    std::tie(base, byteSize) = getWasmBufferFromValue(exec, source);
+    if (UNLIKELY(scope.exception())) {
+        Exception* exception = scope.exception();
+        scope.clearException();
+        promise->reject(exec, exception->value());
+        scope.clearException();
+        return false;
+    }
+
+    compiler.addBytes(base, byteSize);
+    return true;
+}
+
+void GlobalObject::compileStreaming(JSGlobalObject*, ExecState* exec, JSPromiseDeferred* promise, JSValue source)
+{
+    auto compiler = WebAssemblyPrototype::createStreamingCompiler(exec->vm());
+    if (addStreamingSource(exec, promise, *compiler, source))
+        WebAssemblyPrototype::webAssemblyModuleValidateStreaming(exec, promise, *compiler);
+}
+
+void GlobalObject::instantiateStreaming(JSGlobalObject*, ExecState* exec, JSPromiseDeferred* promise, JSValue source, JSObject* importObject)
+{
+    auto compiler = WebAssemblyPrototype::createStreamingCompiler(exec->vm());
+    if (addStreamingSource(exec, promise, *compiler, source))
+        WebAssemblyPrototype::webAssemblyModuleInstantiateStreaming(exec, promise, *compiler, importObject);
+}
+#endif
+
 static EncodedJSValue printInternal(ExecState* exec, FILE* out)
 {
     VM& vm = exec->vm();
@@ -1354,6 +1427,32 @@ EncodedJSValue JSC_HOST_CALL functionCheckSyntax(ExecState* exec)
     return JSValue::encode(jsNumber(stopWatch.getElapsedMS()));
 }
 
+// Like load(), but generates the file's code with prepareProgram() and hands the result to evaluate().
+EncodedJSValue JSC_HOST_CALL functionLoadPrepared(ExecState* exec)
+{
+    VM& vm = exec->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    String fileName = exec->argument(0).toWTFString(exec);
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    Vector<char> script;
+    if (!fetchScriptFromLocalFileSystem(fileName, script))
+        return JSValue::encode(throwException(exec, scope, createError(exec, "Could not open file."_s)));
+
+    JSGlobalObject* globalObject = exec->lexicalGlobalObject();
+
+    JSValue syntaxException;
+    Strong<ProgramExecutable> program = prepareProgram(globalObject->globalExec(), jscSource(script, SourceOrigin { absolutePath(fileName) }, fileName), &syntaxException);
+    if (!program)
+        return JSValue::encode(throwException(exec, scope, syntaxException));
+
+    NakedPtr<Exception> evaluationException;
+    JSValue result = evaluate(globalObject->globalExec(), program.get(), JSValue(), evaluationException);
+    if (evaluationException)
+        throwException(exec, scope, evaluationException);
+    return JSValue::encode(result);
+}
+
 #if ENABLE(SAMPLING_FLAGS)
 EncodedJSValue JSC_HOST_CALL functionSetSamplingFlags(ExecState* exec)
 {
@@ -1470,6 +1569,14 @@ Message::Message(ArrayBufferContents&& contents, int32_t index)
 {
 }
 
+#if ENABLE(WEBASSEMBLY)
+Message::Message(Ref<Wasm::Memory>&& memory, int32_t index)
+    : m_memory(WTFMove(memory))
+    , m_index(index)
+{
+}
+#endif
+
 Message::~Message()
 {
 }
@@ -1672,12 +1779,23 @@ EncodedJSValue JSC_HOST_CALL functionDollarAgentReceiveBroadcast(ExecState* exec
         message = Worker::current().dequeue();
     }
     
-    RefPtr<ArrayBuffer> nativeBuffer = ArrayBuffer::create(message->releaseContents());
-    ArrayBufferSharingMode sharingMode = nativeBuffer->sharingMode();
-    JSArrayBuffer* jsBuffer = JSArrayBuffer::create(vm, exec->lexicalGlobalObject()->arrayBufferStructure(sharingMode), WTFMove(nativeBuffer));
+    JSObject* shared;
+#if ENABLE(WEBASSEMBLY)
+    if (Wasm::Memory* memory = message->memory()) {
+        JSWebAssemblyMemory* jsMemory = JSWebAssemblyMemory::create(exec, vm, exec->lexicalGlobalObject()->WebAssemblyMemoryStructure());
+        RETURN_IF_EXCEPTION(scope, encodedJSValue());
+        jsMemory->adopt(makeRef(*memory));
+        shared = jsMemory;
+    } else
+#endif
+    {
+        RefPtr<ArrayBuffer> nativeBuffer = ArrayBuffer::create(message->releaseContents());
+        ArrayBufferSharingMode sharingMode = nativeBuffer->sharingMode();
+        shared = JSArrayBuffer::create(vm, exec->lexicalGlobalObject()->arrayBufferStructure(sharingMode), WTFMove(nativeBuffer));
+    }
     
     MarkedArgumentBuffer args;
-    args.append(jsBuffer);
+    args.append(shared);
     args.append(jsNumber(message->index()));
     if (UNLIKELY(args.hasOverflowed()))
         return JSValue::encode(throwOutOfMemoryError(exec, scope));
@@ -1716,13 +1834,26 @@ EncodedJSValue JSC_HOST_CALL functionDollarAgentBroadcast(ExecState* exec)
     VM& vm = exec->vm();
     auto scope = DECLARE_THROW_SCOPE(vm);
 
+    int32_t index = exec->argument(1).toInt32(exec);
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+
+#if ENABLE(WEBASSEMBLY)
+    // Each agent wraps a broadcast shared WebAssembly.Memory in its own WebAssembly.Memory object.
+    if (JSWebAssemblyMemory* jsMemory = jsDynamicCast<JSWebAssemblyMemory*>(vm, exec->argument(0))) {
+        if (!jsMemory->memory().isShared())
+            return JSValue::encode(throwException(exec, scope, createError(exec, "Expected a shared WebAssembly.Memory"_s)));
+        Workers::singleton().broadcast(
+            [&] (const AbstractLocker& locker, Worker& worker) {
+                worker.enqueue(locker, adoptRef(new Message(makeRef(jsMemory->memory()), index)));
+            });
+        return JSValue::encode(jsUndefined());
+    }
+#endif
+
     JSArrayBuffer* jsBuffer = jsDynamicCast<JSArrayBuffer*>(vm, exec->argument(0));
     if (!jsBuffer || !jsBuffer->isShared())
         return JSValue::encode(throwException(exec, scope, createError(exec, "Expected SharedArrayBuffer"_s)));
     
-    int32_t index = exec->argument(1).toInt32(exec);
-    RETURN_IF_EXCEPTION(scope, encodedJSValue());
-    
     Workers::singleton().broadcast(
         [&] (const AbstractLocker& locker, Worker& worker) {
             ArrayBuffer* nativeBuffer = jsBuffer->impl();
@@ -2123,6 +2254,128 @@ static EncodedJSValue JSC_HOST_CALL functionWebAssemblyMemoryMode(ExecState* exe
     return throwVMTypeError(exec, scope, "WebAssemblyMemoryMode expects either a WebAssembly.Memory or WebAssembly.Instance"_s);
 }
 
+// WebAssemblyFunctionProfile(instance) returns one entry per internal function of the instance's module
+// with its current tier, call count, and per-tier compile time (ms) and machine code size (bytes).
+static EncodedJSValue JSC_HOST_CALL functionWebAssemblyFunctionProfile(ExecState* exec)
+{
+    VM& vm = exec->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    if (!Options::useWebAssembly())
+        return throwVMTypeError(exec, scope, "WebAssemblyFunctionProfile should only be called if the useWebAssembly option is set"_s);
+
+    auto* jsInstance = jsDynamicCast<JSWebAssemblyInstance*>(vm, exec->argument(0));
+    if (!jsInstance)
+        return throwVMTypeError(exec, scope, "WebAssemblyFunctionProfile expects a WebAssembly.Instance"_s);
+
+    Wasm::Instance& instance = jsInstance->instance();
+    Wasm::CodeBlock* codeBlock = instance.codeBlock();
+    if (!codeBlock || !codeBlock->hasFunctionProfiles())
+        return throwVMTypeError(exec, scope, "WebAssemblyFunctionProfile requires the useWebAssemblyFunctionProfiling option"_s);
+
+    const Wasm::ModuleInformation& moduleInformation = instance.module().moduleInformation();
+    uint32_t importCount = moduleInformation.importFunctionCount();
+    uint32_t functionCount = moduleInformation.internalFunctionSignatureIndices.size();
+
+    JSArray* result = constructEmptyArray(exec, nullptr, functionCount);
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+
+    for (uint32_t i = 0; i < functionCount; ++i) {
+        const Wasm::FunctionProfile& profile = codeBlock->functionProfile(i);
+        size_t functionIndexSpace = importCount + i;
+        String name = makeString(Wasm::IndexOrName(functionIndexSpace, moduleInformation.nameSection->get(functionIndexSpace)));
+
+        JSObject* entry = constructEmptyObject(exec);
+        entry->putDirect(vm, Identifier::fromString(&vm, "name"), jsString(&vm, name));
+        entry->putDirect(vm, Identifier::fromString(&vm, "tier"), jsString(&vm, codeBlock->hasOptimizedCode(i) ? "OMG"_s : "BBQ"_s));
+        entry->putDirect(vm, Identifier::fromString(&vm, "calls"), jsNumber(static_cast<double>(profile.callCount)));
+        entry->putDirect(vm, Identifier::fromString(&vm, "bbqCompileTime"), jsNumber(profile.bbqCompileTime.milliseconds()));
+        entry->putDirect(vm, Identifier::fromString(&vm, "omgCompileTime"), jsNumber(profile.omgCompileTime.milliseconds()));
+        entry->putDirect(vm, Identifier::fromString(&vm, "bbqCodeSize"), jsNumber(profile.bbqCodeSize));
+        entry->putDirect(vm, Identifier::fromString(&vm, "omgCodeSize"), jsNumber(profile.omgCodeSize));
+        result->putDirectIndex(exec, i, entry);
+        RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    }
+
+    return JSValue::encode(result);
+}
+
+// WebAssemblyTimeToCompile(bytes, chunkSize, chunkDelaySeconds, streaming) simulates a module
+// arriving over a slow connection: it hands the bytes over chunkSize at a time, chunk i arriving
+// chunkDelaySeconds * i after the first one, and returns the milliseconds between the first chunk
+// arriving and BBQ code for the module being ready. Streaming compiles each function as soon as
+// it arrives; otherwise validation and compilation wait for the last chunk.
+static EncodedJSValue JSC_HOST_CALL functionWebAssemblyTimeToCompile(ExecState* exec)
+{
+    VM& vm = exec->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    if (!Options::useWebAssembly())
+        return throwVMTypeError(exec, scope, "WebAssemblyTimeToCompile should only be called if the useWebAssembly option is set"_s);
+
+    Vector<uint8_t> source = createSourceBufferFromValue(vm, exec, exec->argument(0));
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    double chunkSize = exec->argument(1).toInteger(exec);
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    if (!(chunkSize >= 1))
+        return throwVMRangeError(exec, scope, "WebAssemblyTimeToCompile expects a chunk size of at least one byte"_s);
+    Seconds chunkDelay = Seconds(exec->argument(2).toNumber(exec));
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    bool streaming = exec->argument(3).isUndefined() || exec->argument(3).toBoolean(exec);
+
+    MonotonicTime start;
+    auto forEachChunk = [&] (auto functor) {
+        size_t step = static_cast<size_t>(std::min<double>(chunkSize, source.size() ? source.size() : 1));
+        start = MonotonicTime::now();
+        size_t chunkIndex = 0;
+        for (size_t offset = 0; offset < source.size(); offset += step, ++chunkIndex) {
+            // Arrival times are fixed up front, so time spent on earlier chunks overlaps the
+            // transfer instead of delaying the chunks after it.
+            MonotonicTime arrival = start + chunkDelay * chunkIndex;
+            MonotonicTime now = MonotonicTime::now();
+            if (arrival > now)
+                sleep(arrival - now);
+            functor(source.data() + offset, std::min(step, source.size() - offset));
+        }
+    };
+
+    RefPtr<Wasm::Module> module;
+    String errorMessage;
+    if (streaming) {
+        Wasm::StreamingCompiler compiler(&vm.wasmContext, Wasm::MemoryMode::BoundsChecking, &Wasm::createJSToWasmWrapper, &Wasm::wasmToJSException);
+        forEachChunk([&] (const uint8_t* chunk, size_t length) {
+            compiler.addBytes(chunk, length);
+        });
+        auto result = compiler.finalize();
+        if (result)
+            module = WTFMove(*result);
+        else
+            errorMessage = WTFMove(result.error());
+    } else {
+        Vector<uint8_t> received;
+        forEachChunk([&] (const uint8_t* chunk, size_t length) {
+            received.append(chunk, length);
+        });
+        auto result = Wasm::Module::validateSync(&vm.wasmContext, WTFMove(received));
+        if (result)
+            module = WTFMove(*result);
+        else
+            errorMessage = WTFMove(result.error());
+    }
+
+    if (module) {
+        // A streamed module already has the CodeBlock its functions were compiled into.
+        Ref<Wasm::CodeBlock> codeBlock = module->compileSync(&vm.wasmContext, Wasm::MemoryMode::BoundsChecking, &Wasm::createJSToWasmWrapper, &Wasm::wasmToJSException);
+        if (!codeBlock->runnable())
+            errorMessage = codeBlock->errorMessage();
+    }
+    Seconds elapsed = MonotonicTime::now() - start;
+
+    if (!errorMessage.isNull())
+        return JSValue::encode(throwException(exec, scope, createJSWebAssemblyCompileError(exec, vm, errorMessage)));
+    return JSValue::encode(jsNumber(elapsed.milliseconds()));
+}
+
 #endif // ENABLE(WEBASSEBLY)
 
 // Use SEH for Release builds only to get rid of the crash report dialog
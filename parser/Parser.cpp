@@ -2298,6 +2298,14 @@ template <class TreeBuilder> bool Parser<LexerType>::parseFunctionInfo(TreeBuild
 
         // If we know about this function already, we can use the cached info and skip the parser to the end of the function.
         if (const SourceProviderCacheItem* cachedInfo = TreeBuilder::CanUseFunctionCache ? findCachedFunctionInfo(parametersStart) : 0) {
+            // Items carried over from a previous version of the source were recorded in what may
+            // have been a different context. Only use them if that context is unchanged.
+            if (cachedInfo->parseMode != mode
+                || cachedInfo->isInStrictContext != parentScope->strictMode()
+                || static_cast<ConstructorKind>(cachedInfo->constructorKind) != constructorKind
+                || static_cast<SuperBinding>(cachedInfo->expectedSuperBinding) != expectedSuperBinding)
+                return false;
+
             // If we're in a strict context, the cached function info must say it was strict too.
             ASSERT(!strictMode() || cachedInfo->strictMode);
             JSTokenLocation endLocation;
@@ -2568,6 +2576,8 @@ template <class TreeBuilder> bool Parser<LexerType>::parseFunctionInfo(TreeBuild
         parameters.parameterCount = functionInfo.parameterCount;
         parameters.constructorKind = constructorKind;
         parameters.expectedSuperBinding = expectedSuperBinding;
+        parameters.parseMode = mode;
+        parameters.isInStrictContext = parentScope->strictMode();
         if (functionBodyType == ArrowFunctionBodyExpression) {
             parameters.isBodyArrowExpression = true;
             parameters.tokenType = m_token.m_type;
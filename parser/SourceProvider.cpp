@@ -44,6 +44,17 @@ SourceProvider::~SourceProvider()
 {
 }
 
+void SourceProvider::setPreviousVersion(SourceProvider& previous, const SourceProviderEdit& edit)
+{
+    ASSERT(&previous != this);
+    ASSERT(previous.sourceType() == m_sourceType);
+    ASSERT(source().substring(0, edit.offset) == previous.source().substring(0, edit.offset));
+    ASSERT(source().substring(edit.offset + edit.insertedLength) == previous.source().substring(edit.offset + edit.removedLength));
+    previous.clearPreviousVersion();
+    m_previousVersion = &previous;
+    m_editFromPreviousVersion = edit;
+}
+
 static Lock providerIdLock;
 
 void SourceProvider::getID()
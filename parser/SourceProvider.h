@@ -41,6 +41,14 @@ namespace JSC {
         WebAssembly,
     };
 
+    // Describes how a SourceProvider's text differs from a previous version of the same source:
+    // removedLength characters at offset were replaced by insertedLength characters.
+    struct SourceProviderEdit {
+        unsigned offset { 0 };
+        unsigned removedLength { 0 };
+        unsigned insertedLength { 0 };
+    };
+
     class SourceProvider : public RefCounted<SourceProvider> {
     public:
         static const intptr_t nullID = 1;
@@ -77,6 +85,14 @@ namespace JSC {
         void setSourceURLDirective(const String& sourceURL) { m_sourceURLDirective = sourceURL; }
         void setSourceMappingURLDirective(const String& sourceMappingURL) { m_sourceMappingURLDirective = sourceMappingURL; }
 
+        // Lets the parser reuse what it learned about the unchanged functions of an earlier
+        // version of this source. Only one version of history is kept: the previous provider's
+        // own link is dropped. Must be called before this provider is first parsed.
+        JS_EXPORT_PRIVATE void setPreviousVersion(SourceProvider&, const SourceProviderEdit&);
+        SourceProvider* previousVersion() const { return m_previousVersion.get(); }
+        const SourceProviderEdit& editFromPreviousVersion() const { return m_editFromPreviousVersion; }
+        void clearPreviousVersion() { m_previousVersion = nullptr; }
+
     private:
         JS_EXPORT_PRIVATE void getID();
 
@@ -88,6 +104,8 @@ namespace JSC {
         String m_sourceMappingURLDirective;
         TextPosition m_startPosition;
         uintptr_t m_id { 0 };
+        RefPtr<SourceProvider> m_previousVersion;
+        SourceProviderEdit m_editFromPreviousVersion;
     };
 
     class StringSourceProvider : public SourceProvider {
@@ -27,6 +27,7 @@
 #include "SourceProviderCache.h"
 
 #include "JSCInlines.h"
+#include "SourceProvider.h"
 
 namespace JSC {
 
@@ -45,4 +46,63 @@ void SourceProviderCache::add(int sourcePosition, std::unique_ptr<SourceProvider
     m_map.add(sourcePosition, WTFMove(item));
 }
 
+// Counts the line terminators in source[start, end], the way the lexer does: a CR LF pair is a
+// single terminator.
+static unsigned countLineTerminators(StringView source, unsigned start, unsigned end)
+{
+    unsigned count = 0;
+    for (unsigned i = start; i <= end && i < source.length(); ++i) {
+        UChar character = source[i];
+        if (character == '\r') {
+            if (i + 1 <= end && i + 1 < source.length() && source[i + 1] == '\n')
+                ++i;
+            ++count;
+        } else if (character == '\n' || character == 0x2028 || character == 0x2029)
+            ++count;
+    }
+    return count;
+}
+
+void SourceProviderCache::addUnchangedItems(const SourceProviderCache& previousCache, const SourceProvider& previousProvider, const SourceProvider& newProvider, const SourceProviderEdit& edit)
+{
+    if (previousProvider.startPosition() != newProvider.startPosition())
+        return;
+
+    StringView previousSource = previousProvider.source();
+    StringView newSource = newProvider.source();
+    unsigned previousEditEnd = edit.offset + edit.removedLength;
+    unsigned newEditEnd = edit.offset + edit.insertedLength;
+    if (previousEditEnd > previousSource.length() || newEditEnd > newSource.length())
+        return;
+    if (previousSource.length() - previousEditEnd != newSource.length() - newEditEnd)
+        return;
+
+    // Lines are counted from one character before the edit through the first unchanged character
+    // after it, so a CR LF pair split by either edge of the edit is treated the same way in both
+    // versions.
+    unsigned countStart = edit.offset ? edit.offset - 1 : 0;
+    int lineDelta = static_cast<int>(countLineTerminators(newSource, countStart, newEditEnd)) - static_cast<int>(countLineTerminators(previousSource, countStart, previousEditEnd));
+    int offsetDelta = static_cast<int>(edit.insertedLength) - static_cast<int>(edit.removedLength);
+
+    for (auto& entry : previousCache.m_map) {
+        const SourceProviderCacheItem& item = *entry.value;
+
+        // An arrow function's extent and meaning depend on the text around it (an expression
+        // body can absorb following tokens, and await/yield follow the enclosing function), so
+        // those are always re-parsed.
+        if (isArrowFunctionParseMode(item.parseMode))
+            continue;
+
+        if (item.lastTokenEndOffset < edit.offset && item.endFunctionOffset < edit.offset) {
+            m_map.add(entry.key, SourceProviderCacheItem::createShifted(item, 0, 0));
+            continue;
+        }
+
+        // The function, and the start of the line its last token is on, must both begin after
+        // the first unchanged character following the edit.
+        if (item.functionNameStart > previousEditEnd && static_cast<unsigned>(entry.key) > previousEditEnd && item.lastTokenLineStartOffset > previousEditEnd)
+            m_map.add(entry.key + offsetDelta, SourceProviderCacheItem::createShifted(item, offsetDelta, lineDelta));
+    }
+}
+
 }
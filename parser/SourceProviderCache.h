@@ -31,6 +31,9 @@
 
 namespace JSC {
 
+class SourceProvider;
+struct SourceProviderEdit;
+
 class SourceProviderCache : public RefCounted<SourceProviderCache> {
     WTF_MAKE_FAST_ALLOCATED;
 public:
@@ -41,6 +44,10 @@ public:
     void add(int sourcePosition, std::unique_ptr<SourceProviderCacheItem>);
     const SourceProviderCacheItem* get(int sourcePosition) const { return m_map.get(sourcePosition); }
 
+    // Seeds this cache, which belongs to newProvider, with the items of previousCache that
+    // describe functions lying entirely outside the edited range.
+    void addUnchangedItems(const SourceProviderCache& previousCache, const SourceProvider& previousProvider, const SourceProvider& newProvider, const SourceProviderEdit&);
+
 private:
     HashMap<int, std::unique_ptr<SourceProviderCacheItem>, WTF::IntHash<int>, WTF::UnsignedWithZeroKeyHashTraits<int>> m_map;
 };
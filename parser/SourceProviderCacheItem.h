@@ -52,6 +52,8 @@ struct SourceProviderCacheItemCreationParameters {
     JSTokenType tokenType { CLOSEBRACE };
     ConstructorKind constructorKind;
     SuperBinding expectedSuperBinding;
+    SourceParseMode parseMode;
+    bool isInStrictContext;
 };
 
 #if COMPILER(MSVC)
@@ -63,6 +65,7 @@ class SourceProviderCacheItem {
     WTF_MAKE_FAST_ALLOCATED;
 public:
     static std::unique_ptr<SourceProviderCacheItem> create(const SourceProviderCacheItemCreationParameters&);
+    static std::unique_ptr<SourceProviderCacheItem> createShifted(const SourceProviderCacheItem&, int offsetDelta, int lineDelta);
     ~SourceProviderCacheItem();
 
     JSToken endFunctionToken() const 
@@ -97,11 +100,14 @@ public:
     InnerArrowFunctionCodeFeatures innerArrowFunctionFeatures;
     bool isBodyArrowExpression;
     JSTokenType tokenType;
+    SourceParseMode parseMode;
+    bool isInStrictContext;
 
     UniquedStringImpl** usedVariables() const { return const_cast<UniquedStringImpl**>(m_variables); }
 
 private:
     SourceProviderCacheItem(const SourceProviderCacheItemCreationParameters&);
+    SourceProviderCacheItem(const SourceProviderCacheItem&, int offsetDelta, int lineDelta);
 
     UniquedStringImpl* m_variables[0];
 };
@@ -139,6 +145,8 @@ inline SourceProviderCacheItem::SourceProviderCacheItem(const SourceProviderCach
     , innerArrowFunctionFeatures(parameters.innerArrowFunctionFeatures)
     , isBodyArrowExpression(parameters.isBodyArrowExpression)
     , tokenType(parameters.tokenType)
+    , parseMode(parameters.parseMode)
+    , isInStrictContext(parameters.isInStrictContext)
 {
     for (unsigned i = 0; i < usedVariablesCount; ++i) {
         m_variables[i] = parameters.usedVariables[i];
@@ -146,6 +154,41 @@ inline SourceProviderCacheItem::SourceProviderCacheItem(const SourceProviderCach
     }
 }
 
+inline std::unique_ptr<SourceProviderCacheItem> SourceProviderCacheItem::createShifted(const SourceProviderCacheItem& other, int offsetDelta, int lineDelta)
+{
+    size_t objectSize = sizeof(SourceProviderCacheItem) + sizeof(UniquedStringImpl*) * other.usedVariablesCount;
+    void* slot = fastMalloc(objectSize);
+    return std::unique_ptr<SourceProviderCacheItem>(new (slot) SourceProviderCacheItem(other, offsetDelta, lineDelta));
+}
+
+inline SourceProviderCacheItem::SourceProviderCacheItem(const SourceProviderCacheItem& other, int offsetDelta, int lineDelta)
+    : functionNameStart(other.functionNameStart + offsetDelta)
+    , needsFullActivation(other.needsFullActivation)
+    , endFunctionOffset(other.endFunctionOffset + offsetDelta)
+    , usesEval(other.usesEval)
+    , lastTokenLine(other.lastTokenLine + lineDelta)
+    , strictMode(other.strictMode)
+    , lastTokenStartOffset(other.lastTokenStartOffset + offsetDelta)
+    , lastTokenEndOffset(other.lastTokenEndOffset + offsetDelta)
+    , constructorKind(other.constructorKind)
+    , parameterCount(other.parameterCount)
+    , expectedSuperBinding(other.expectedSuperBinding)
+    , needsSuperBinding(other.needsSuperBinding)
+    , functionLength(other.functionLength)
+    , lastTokenLineStartOffset(other.lastTokenLineStartOffset + offsetDelta)
+    , usedVariablesCount(other.usedVariablesCount)
+    , innerArrowFunctionFeatures(other.innerArrowFunctionFeatures)
+    , isBodyArrowExpression(other.isBodyArrowExpression)
+    , tokenType(other.tokenType)
+    , parseMode(other.parseMode)
+    , isInStrictContext(other.isInStrictContext)
+{
+    for (unsigned i = 0; i < usedVariablesCount; ++i) {
+        m_variables[i] = other.m_variables[i];
+        m_variables[i]->ref();
+    }
+}
+
 #if COMPILER(MSVC)
 #pragma warning(pop)
 #endif
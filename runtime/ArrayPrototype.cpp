@@ -28,6 +28,7 @@
 #include "ArrayConstructor.h"
 #include "BuiltinNames.h"
 #include "ButterflyInlines.h"
+#include "CachedCall.h"
 #include "CodeBlock.h"
 #include "Error.h"
 #include "GetterSetter.h"
@@ -1429,6 +1430,211 @@ EncodedJSValue JSC_HOST_CALL arrayProtoPrivateFuncAppendMemcpy(ExecState* exec)
     return JSValue::encode(jsUndefined());
 }
 
+static unsigned writeInt32AsDecimal(int32_t value, LChar* buffer)
+{
+    LChar digits[10];
+    unsigned digitCount = 0;
+    uint32_t magnitude = value < 0 ? -static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+    do {
+        digits[digitCount++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude);
+
+    unsigned length = 0;
+    if (value < 0)
+        buffer[length++] = '-';
+    while (digitCount)
+        buffer[length++] = digits[--digitCount];
+    return length;
+}
+
+// Orders int32s the way the default comparator orders their decimal strings, without creating the strings.
+static bool int32DecimalStringLessThan(int32_t a, int32_t b)
+{
+    LChar aBuffer[11];
+    LChar bBuffer[11];
+    unsigned aLength = writeInt32AsDecimal(a, aBuffer);
+    unsigned bLength = writeInt32AsDecimal(b, bBuffer);
+    if (int result = memcmp(aBuffer, bBuffer, std::min(aLength, bLength)))
+        return result < 0;
+    return aLength < bLength;
+}
+
+// Stable bottom-up merge sort of {order}. {rightFirst} returns std::nullopt if it threw,
+// in which case we give up and return false.
+template<typename RightFirst>
+static bool stableSortOrder(Vector<unsigned>& order, const RightFirst& rightFirst)
+{
+    unsigned length = order.size();
+    Vector<unsigned> buffer(length);
+    unsigned* source = order.data();
+    unsigned* destination = buffer.data();
+    for (unsigned width = 1; width < length; width *= 2) {
+        for (unsigned start = 0; start < length; start += 2 * width) {
+            unsigned left = start;
+            unsigned leftEnd = std::min(start + width, length);
+            unsigned right = leftEnd;
+            unsigned rightEnd = std::min(leftEnd + width, length);
+            unsigned index = start;
+            while (left < leftEnd && right < rightEnd) {
+                std::optional<bool> takeRight = rightFirst(source[right], source[left]);
+                if (!takeRight)
+                    return false;
+                destination[index++] = *takeRight ? source[right++] : source[left++];
+            }
+            while (left < leftEnd)
+                destination[index++] = source[left++];
+            while (right < rightEnd)
+                destination[index++] = source[right++];
+        }
+        std::swap(source, destination);
+    }
+
+    if (source != order.data())
+        memcpy(order.data(), source, length * sizeof(unsigned));
+    return true;
+}
+
+// Sorts a JSArray with Int32, Double or Contiguous storage and no holes without the
+// temporary arrays of the sort() builtin. Returns false, having done nothing observable,
+// when the array needs the generic path.
+EncodedJSValue JSC_HOST_CALL arrayProtoPrivateFuncSortFastPath(ExecState* exec)
+{
+    VM& vm = exec->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    JSValue arrayValue = exec->argument(0);
+    JSValue comparator = exec->argument(1);
+    if (!isJSArray(arrayValue))
+        return JSValue::encode(jsBoolean(false));
+
+    JSArray* array = asArray(arrayValue);
+    unsigned length = array->length();
+    IndexingType indexingType = array->indexingType();
+    if (!hasInt32(indexingType) && !hasDouble(indexingType) && !hasContiguous(indexingType))
+        return JSValue::encode(jsBoolean(false));
+
+    if (hasDouble(indexingType)) {
+        if (containsHole(array->butterfly()->contiguousDouble().data(), length))
+            return JSValue::encode(jsBoolean(false));
+    } else {
+        auto* data = array->butterfly()->contiguous().data();
+        for (unsigned i = 0; i < length; ++i) {
+            // undefined is sorted to the end without calling the comparator; leave that to the builtin.
+            if (isHole(data[i]) || data[i].get().isUndefined())
+                return JSValue::encode(jsBoolean(false));
+        }
+    }
+
+    if (comparator.isUndefined()) {
+        if (hasInt32(indexingType)) {
+            Vector<int32_t> values(length);
+            auto* data = array->butterfly()->contiguous().data();
+            for (unsigned i = 0; i < length; ++i)
+                values[i] = data[i].get().asInt32();
+            std::stable_sort(values.begin(), values.end(), int32DecimalStringLessThan);
+
+            array->ensureWritable(vm);
+            data = array->butterfly()->contiguous().data();
+            for (unsigned i = 0; i < length; ++i)
+                data[i].setWithoutWriteBarrier(jsNumber(values[i]));
+            return JSValue::encode(jsBoolean(true));
+        }
+
+        // Doubles have no cheap ordering by their string form.
+        if (!hasContiguous(indexingType))
+            return JSValue::encode(jsBoolean(false));
+
+        Vector<JSValue> values(length);
+        auto* data = array->butterfly()->contiguous().data();
+        for (unsigned i = 0; i < length; ++i) {
+            JSValue value = data[i].get();
+            if (!value.isString())
+                return JSValue::encode(jsBoolean(false));
+            values[i] = value;
+        }
+        // Resolve ropes up front so comparisons cannot allocate or throw. Every value is
+        // still held by the butterfly, so the unmarked copy cannot lose anything to GC.
+        for (JSValue value : values) {
+            asString(value)->value(exec);
+            RETURN_IF_EXCEPTION(scope, encodedJSValue());
+        }
+        std::stable_sort(values.begin(), values.end(), [] (JSValue a, JSValue b) {
+            return codePointCompareLessThan(asString(a)->tryGetValue(), asString(b)->tryGetValue());
+        });
+
+        array->ensureWritable(vm);
+        data = array->butterfly()->contiguous().data();
+        for (unsigned i = 0; i < length; ++i)
+            data[i].setWithoutWriteBarrier(values[i]);
+        vm.heap.writeBarrier(array);
+        return JSValue::encode(jsBoolean(true));
+    }
+
+    CallData callData;
+    CallType callType = getCallData(vm, comparator, callData);
+    ASSERT(callType != CallType::None);
+
+    // The comparator may change the array, so sort a GC visible copy and store it back with
+    // ordinary puts.
+    MarkedArgumentBuffer values;
+    if (hasDouble(indexingType)) {
+        auto* data = array->butterfly()->contiguousDouble().data();
+        for (unsigned i = 0; i < length; ++i)
+            values.append(jsNumber(data[i]));
+    } else {
+        auto* data = array->butterfly()->contiguous().data();
+        for (unsigned i = 0; i < length; ++i)
+            values.append(data[i].get());
+    }
+    if (UNLIKELY(values.hasOverflowed())) {
+        throwOutOfMemoryError(exec, scope);
+        return encodedJSValue();
+    }
+
+    // Matches the builtin: a negative result, or false, puts the right value first.
+    auto resultPutsRightFirst = [&] (JSValue result) -> std::optional<bool> {
+        RETURN_IF_EXCEPTION(scope, std::nullopt);
+        if (result.isBoolean())
+            return !result.asBoolean();
+        bool isNegative = jsLess<true>(exec, result, jsNumber(0));
+        RETURN_IF_EXCEPTION(scope, std::nullopt);
+        return isNegative;
+    };
+
+    Vector<unsigned> order(length);
+    for (unsigned i = 0; i < length; ++i)
+        order[i] = i;
+
+    bool sorted;
+    if (callType == CallType::JS) {
+        CachedCall cachedCall(exec, jsCast<JSFunction*>(comparator), 2);
+        RETURN_IF_EXCEPTION(scope, encodedJSValue());
+        sorted = stableSortOrder(order, [&] (unsigned right, unsigned left) {
+            cachedCall.clearArguments();
+            cachedCall.appendArgument(values.at(right));
+            cachedCall.appendArgument(values.at(left));
+            cachedCall.setThis(jsUndefined());
+            return resultPutsRightFirst(cachedCall.call());
+        });
+    } else {
+        sorted = stableSortOrder(order, [&] (unsigned right, unsigned left) {
+            MarkedArgumentBuffer arguments;
+            arguments.append(values.at(right));
+            arguments.append(values.at(left));
+            ASSERT(!arguments.hasOverflowed());
+            return resultPutsRightFirst(call(exec, comparator, callType, callData, jsUndefined(), arguments));
+        });
+    }
+    if (!sorted)
+        return encodedJSValue();
+
+    for (unsigned i = 0; i < length; ++i) {
+        array->putByIndexInline(exec, i, values.at(order[i]), true);
+        RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    }
+    return JSValue::encode(jsBoolean(true));
+}
 
 // -------------------- ArrayPrototype.constructor Watchpoint ------------------
 
@@ -38,6 +38,7 @@
 #include "JSModuleRecord.h"
 #include "JSWithScope.h"
 #include "ModuleAnalyzer.h"
+#include "ModuleProgramExecutable.h"
 #include "Parser.h"
 #include "ProgramExecutable.h"
 #include "ScriptProfilingScope.h"
@@ -87,6 +88,42 @@ bool checkModuleSyntax(ExecState* exec, const SourceCode& source, ParserError& e
     return true;
 }
 
+Strong<ProgramExecutable> prepareProgram(ExecState* exec, const SourceCode& source, JSValue* returnedException)
+{
+    VM& vm = exec->vm();
+    JSLockHolder lock(vm);
+    RELEASE_ASSERT(vm.atomicStringTable() == Thread::current().atomicStringTable());
+
+    ProgramExecutable* program = ProgramExecutable::create(exec, source);
+    if (JSObject* error = program->prepare(vm, exec->lexicalGlobalObject())) {
+        if (returnedException)
+            *returnedException = error;
+        return { };
+    }
+    return Strong<ProgramExecutable>(vm, program);
+}
+
+bool prepareModuleProgram(ExecState* exec, const SourceCode& source, JSValue* returnedException)
+{
+    VM& vm = exec->vm();
+    JSLockHolder lock(vm);
+    auto scope = DECLARE_CATCH_SCOPE(vm);
+    RELEASE_ASSERT(vm.atomicStringTable() == Thread::current().atomicStringTable());
+
+    if (!Options::useCodeCache() || exec->lexicalGlobalObject()->hasDebugger())
+        return true;
+
+    // Creating the executable generates its unlinked code through the CodeCache.
+    ModuleProgramExecutable::create(exec, source);
+    if (Exception* exception = scope.exception()) {
+        if (returnedException)
+            *returnedException = exception->value();
+        scope.clearException();
+        return false;
+    }
+    return true;
+}
+
 JSValue evaluate(ExecState* exec, const SourceCode& source, JSValue thisValue, NakedPtr<Exception>& returnedException)
 {
     VM& vm = exec->vm();
@@ -112,6 +149,31 @@ JSValue evaluate(ExecState* exec, const SourceCode& source, JSValue thisValue, N
     return result;
 }
 
+JSValue evaluate(ExecState* exec, ProgramExecutable* program, JSValue thisValue, NakedPtr<Exception>& returnedException)
+{
+    VM& vm = exec->vm();
+    JSLockHolder lock(vm);
+    auto scope = DECLARE_CATCH_SCOPE(vm);
+    RELEASE_ASSERT(vm.atomicStringTable() == Thread::current().atomicStringTable());
+    RELEASE_ASSERT(!vm.isCollectorBusyOnCurrentThread());
+
+    CodeProfiling profile(program->source());
+
+    if (!thisValue || thisValue.isUndefinedOrNull())
+        thisValue = vm.vmEntryGlobalObject(exec);
+    JSObject* thisObj = jsCast<JSObject*>(thisValue.toThis(exec, NotStrictMode));
+    JSValue result = vm.interpreter->executeProgram(program, exec, thisObj);
+
+    if (scope.exception()) {
+        returnedException = scope.exception();
+        scope.clearException();
+        return jsUndefined();
+    }
+
+    RELEASE_ASSERT(result);
+    return result;
+}
+
 JSValue profiledEvaluate(ExecState* exec, ProfilingReason reason, const SourceCode& source, JSValue thisValue, NakedPtr<Exception>& returnedException)
 {
     VM& vm = exec->vm();
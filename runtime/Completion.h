@@ -24,6 +24,7 @@
 
 #include "CallData.h"
 #include "JSCJSValue.h"
+#include "Strong.h"
 #include <wtf/NakedPtr.h>
 
 namespace JSC {
@@ -32,6 +33,7 @@ class Exception;
 class ExecState;
 class JSObject;
 class ParserError;
+class ProgramExecutable;
 class SourceCode;
 class VM;
 class JSInternalPromise;
@@ -40,7 +42,18 @@ JS_EXPORT_PRIVATE bool checkSyntax(VM&, const SourceCode&, ParserError&);
 JS_EXPORT_PRIVATE bool checkSyntax(ExecState*, const SourceCode&, JSValue* exception = 0);
 JS_EXPORT_PRIVATE bool checkModuleSyntax(ExecState*, const SourceCode&, ParserError&);
 
+// Parse the source and generate its unlinked bytecode without linking or running it. These take the
+// JSLock like evaluate() does, so they cannot overlap with script execution in the same VM; they
+// only move the parse ahead of the evaluation, e.g. to while the embedder waits on the network.
+// prepareProgram() returns the program to pass to evaluate() once, or null and the syntax error.
+// prepareModuleProgram() can only fill the CodeCache, which the module loader consults later. It
+// does nothing when the CodeCache is disabled or a debugger is attached, because generating a
+// module's code reports the source to the debugger before the module is evaluated.
+JS_EXPORT_PRIVATE Strong<ProgramExecutable> prepareProgram(ExecState*, const SourceCode&, JSValue* exception = 0);
+JS_EXPORT_PRIVATE bool prepareModuleProgram(ExecState*, const SourceCode&, JSValue* exception = 0);
+
 JS_EXPORT_PRIVATE JSValue evaluate(ExecState*, const SourceCode&, JSValue thisValue, NakedPtr<Exception>& returnedException);
+JS_EXPORT_PRIVATE JSValue evaluate(ExecState*, ProgramExecutable*, JSValue thisValue, NakedPtr<Exception>& returnedException);
 inline JSValue evaluate(ExecState* exec, const SourceCode& sourceCode, JSValue thisValue = JSValue())
 {
     NakedPtr<Exception> unused;
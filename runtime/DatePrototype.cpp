@@ -533,6 +533,17 @@ EncodedJSValue JSC_HOST_CALL dateProtoFuncToUTCString(ExecState* exec)
     return formateDateInstance(exec, DateTimeFormatDateAndTime, asUTCVariant);
 }
 
+static inline LChar* appendDigits(LChar* buffer, int value, unsigned count)
+{
+    ASSERT(value >= 0);
+    for (unsigned i = count; i--;) {
+        buffer[i] = '0' + value % 10;
+        value /= 10;
+    }
+    ASSERT(!value);
+    return buffer + count;
+}
+
 EncodedJSValue JSC_HOST_CALL dateProtoFuncToISOString(ExecState* exec)
 {
     VM& vm = exec->vm();
@@ -548,25 +559,41 @@ EncodedJSValue JSC_HOST_CALL dateProtoFuncToISOString(ExecState* exec)
     const GregorianDateTime* gregorianDateTime = thisDateObj->gregorianDateTimeUTC(exec);
     if (!gregorianDateTime)
         return JSValue::encode(jsNontrivialString(exec, String("Invalid Date"_s)));
-    // Maximum amount of space we need in buffer: 7 (max. digits in year) + 2 * 5 (2 characters each for month, day, hour, minute, second) + 4 (. + 3 digits for milliseconds)
-    // 6 for formatting and one for null termination = 28. We add one extra character to allow us to force null termination.
-    char buffer[28];
+
     // If the year is outside the bounds of 0 and 9999 inclusive we want to use the extended year format (ES 15.9.1.15.1).
     int ms = static_cast<int>(fmod(thisDateObj->internalNumber(), msPerSecond));
     if (ms < 0)
         ms += msPerSecond;
 
-    int charactersWritten;
-    if (gregorianDateTime->year() > 9999 || gregorianDateTime->year() < 0)
-        charactersWritten = snprintf(buffer, sizeof(buffer), "%+07d-%02d-%02dT%02d:%02d:%02d.%03dZ", gregorianDateTime->year(), gregorianDateTime->month() + 1, gregorianDateTime->monthDay(), gregorianDateTime->hour(), gregorianDateTime->minute(), gregorianDateTime->second(), ms);
-    else
-        charactersWritten = snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ", gregorianDateTime->year(), gregorianDateTime->month() + 1, gregorianDateTime->monthDay(), gregorianDateTime->hour(), gregorianDateTime->minute(), gregorianDateTime->second(), ms);
-
-    ASSERT(charactersWritten > 0 && static_cast<unsigned>(charactersWritten) < sizeof(buffer));
-    if (static_cast<unsigned>(charactersWritten) >= sizeof(buffer))
-        return JSValue::encode(jsEmptyString(exec));
-
-    return JSValue::encode(jsNontrivialString(exec, String(buffer, charactersWritten)));
+    int year = gregorianDateTime->year();
+    bool isExtendedYear = year > 9999 || year < 0;
+    // "YYYY-MM-DDTHH:mm:ss.sssZ" is 24 characters, and the extended year form adds a sign and two more digits.
+    unsigned length = isExtendedYear ? 27 : 24;
+
+    // Write the digits straight into the new string rather than formatting into a buffer and copying.
+    LChar* buffer;
+    auto impl = StringImpl::createUninitialized(length, buffer);
+    if (isExtendedYear) {
+        *buffer++ = year < 0 ? '-' : '+';
+        buffer = appendDigits(buffer, std::abs(year), 6);
+    } else
+        buffer = appendDigits(buffer, year, 4);
+    *buffer++ = '-';
+    buffer = appendDigits(buffer, gregorianDateTime->month() + 1, 2);
+    *buffer++ = '-';
+    buffer = appendDigits(buffer, gregorianDateTime->monthDay(), 2);
+    *buffer++ = 'T';
+    buffer = appendDigits(buffer, gregorianDateTime->hour(), 2);
+    *buffer++ = ':';
+    buffer = appendDigits(buffer, gregorianDateTime->minute(), 2);
+    *buffer++ = ':';
+    buffer = appendDigits(buffer, gregorianDateTime->second(), 2);
+    *buffer++ = '.';
+    buffer = appendDigits(buffer, ms, 3);
+    *buffer++ = 'Z';
+    ASSERT(buffer == impl->characters8() + length);
+
+    return JSValue::encode(jsNontrivialString(exec, String(WTFMove(impl))));
 }
 
 EncodedJSValue JSC_HOST_CALL dateProtoFuncToDateString(ExecState* exec)
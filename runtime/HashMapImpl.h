@@ -93,7 +93,6 @@ public:
         HashMapBucket* bucket = new (NotNull, allocateCell<HashMapBucket<Data>>(vm.heap)) HashMapBucket(vm, selectStructure(vm));
         bucket->finishCreation(vm);
         ASSERT(!bucket->next());
-        ASSERT(!bucket->prev());
         return bucket;
     }
 
@@ -116,10 +115,6 @@ public:
     {
         m_next.set(vm, this, bucket);
     }
-    ALWAYS_INLINE void setPrev(VM& vm, HashMapBucket* bucket)
-    {
-        m_prev.set(vm, this, bucket);
-    }
 
     ALWAYS_INLINE void setKey(VM& vm, JSValue key)
     {
@@ -145,7 +140,6 @@ public:
     static void visitChildren(JSCell*, SlotVisitor&);
 
     ALWAYS_INLINE HashMapBucket* next() const { return m_next.get(); }
-    ALWAYS_INLINE HashMapBucket* prev() const { return m_prev.get(); }
 
     ALWAYS_INLINE bool deleted() const { return !key(); }
     ALWAYS_INLINE void makeDeleted(VM& vm)
@@ -183,8 +177,10 @@ public:
     }
 
 private:
+    // Buckets are singly linked in insertion order. Removed buckets stay on the list, marked
+    // deleted, until the next rehash unlinks them, so no back pointer is needed. This keeps a
+    // Map bucket within a 32 byte cell.
     WriteBarrier<HashMapBucket> m_next;
-    WriteBarrier<HashMapBucket> m_prev;
     Data m_data;
 };
 
@@ -488,12 +484,10 @@ public:
         if (!bucket)
             return false;
 
+        // The bucket stays on the iteration list until the next rehash. Every walker of the
+        // list already skips deleted buckets, as live iterators may be parked on one.
         VM& vm = exec->vm();
-        HashMapBucketType* impl = *bucket;
-        impl->next()->setPrev(vm, impl->prev());
-        impl->prev()->setNext(vm, impl->next());
-        impl->makeDeleted(vm);
-
+        (*bucket)->makeDeleted(vm);
         *bucket = deletedValue();
 
         ++m_deleteCount;
@@ -527,7 +521,6 @@ public:
             bucket = next;
         }
         m_head->setNext(vm, m_tail.get());
-        m_tail->setPrev(vm, m_head.get());
         m_capacity = 4;
         makeAndSetNewBuffer(exec, vm);
         checkConsistency();
@@ -561,7 +554,7 @@ public:
         size_t size = sizeof(HashMapImpl);
         size += bufferSizeInBytes();
         size += 2 * sizeof(HashMapBucketType); // Head and tail members.
-        size += m_keyCount * sizeof(HashMapBucketType); // Number of members that are on the list.
+        size += (m_keyCount + m_deleteCount) * sizeof(HashMapBucketType); // Live and not yet unlinked deleted members of the list.
         return size;
     }
 
@@ -582,7 +575,6 @@ private:
         m_tail.set(vm, this, HashMapBucketType::create(vm));
 
         m_head->setNext(vm, m_tail.get());
-        m_tail->setPrev(vm, m_head.get());
         ASSERT(m_head->deleted());
         ASSERT(m_tail->deleted());
     }
@@ -631,7 +623,6 @@ private:
         ASSERT(!newEntry->deleted());
         HashMapBucketType* newTail = HashMapBucketType::create(vm);
         m_tail.set(vm, this, newTail);
-        newTail->setPrev(vm, newEntry);
         ASSERT(newTail->deleted());
         newEntry->setNext(vm, newTail);
 
@@ -671,12 +662,23 @@ private:
             assertBufferIsEmpty();
         }
 
+        // Unlink the deleted buckets that remove() left on the list. Their own next pointers are
+        // left alone so that an iterator parked on one still finds the rest of the list.
+        HashMapBucketType* last = m_head.get();
         HashMapBucketType* iter = m_head->next();
         HashMapBucketType* end = m_tail.get();
         const uint32_t mask = m_capacity - 1;
         RELEASE_ASSERT(!(m_capacity & (m_capacity - 1)));
         HashMapBucketType** buffer = this->buffer();
         while (iter != end) {
+            HashMapBucketType* next = iter->next();
+            if (iter->deleted()) {
+                iter = next;
+                continue;
+            }
+            if (last->next() != iter)
+                last->setNext(vm, iter);
+
             uint32_t index = jsMapHash(exec, vm, iter->key()) & mask;
             EXCEPTION_ASSERT_WITH_MESSAGE(!scope.exception(), "All keys should already be hashed before, so this should not throw because it won't resolve ropes.");
             {
@@ -687,8 +689,11 @@ private:
                 }
             }
             buffer[index] = iter;
-            iter = iter->next();
+            last = iter;
+            iter = next;
         }
+        if (last->next() != end)
+            last->setNext(vm, end);
 
         m_deleteCount = 0;
 
@@ -702,7 +707,8 @@ private:
             HashMapBucketType* end = m_tail.get();
             uint32_t size = 0;
             while (iter != end) {
-                ++size;
+                if (!iter->deleted())
+                    ++size;
                 iter = iter->next();
             }
             ASSERT(size == m_keyCount);
@@ -250,8 +250,27 @@ JSBigInt* JSBigInt::multiply(ExecState* exec, JSBigInt* x, JSBigInt* y)
     JSBigInt* result = JSBigInt::createWithLength(vm, resultLength);
     result->initialize(InitializationType::WithZero);
 
-    for (unsigned i = 0; i < x->length(); i++)
-        multiplyAccumulate(y, x->digit(i), result, i);
+    JSBigInt* longer = x->length() >= y->length() ? x : y;
+    JSBigInt* shorter = longer == x ? y : x;
+    unsigned shorterLength = shorter->length();
+    if (shorterLength < karatsubaThreshold) {
+        for (unsigned i = 0; i < x->length(); i++)
+            multiplyAccumulate(y, x->digit(i), result, i);
+    } else {
+        // Karatsuba needs equally sized operands, so multiply {shorter} with
+        // {shorter}-sized slices of {longer} and accumulate the partial products.
+        Vector<Digit> slice(shorterLength);
+        Vector<Digit> product(2 * shorterLength);
+        for (unsigned i = 0; i < longer->length(); i += shorterLength) {
+            unsigned sliceLength = std::min(shorterLength, longer->length() - i);
+            memcpy(slice.data(), longer->dataStorage() + i, sliceLength * sizeof(Digit));
+            std::fill(slice.begin() + sliceLength, slice.end(), 0);
+            multiplyKaratsuba(slice.data(), shorter->dataStorage(), shorterLength, product.data());
+
+            Digit carry = inplaceAddDigits(result->dataStorage() + i, resultLength - i, product.data(), sliceLength + shorterLength);
+            ASSERT_UNUSED(carry, !carry);
+        }
+    }
 
     result->setSign(x->sign() != y->sign());
     return result->rightTrim(vm);
@@ -627,6 +646,112 @@ void JSBigInt::multiplyAccumulate(JSBigInt* multiplicand, Digit multiplier, JSBi
     }
 }
 
+// Writes the {xLength + yLength} digit product of {x} and {y} to {result}.
+void JSBigInt::multiplyTextbook(const Digit* x, unsigned xLength, const Digit* y, unsigned yLength, Digit* result)
+{
+    std::fill(result, result + xLength + yLength, 0);
+    for (unsigned i = 0; i < xLength; i++) {
+        Digit multiplier = x[i];
+        if (!multiplier)
+            continue;
+
+        Digit carry = 0;
+        for (unsigned j = 0; j < yLength; j++) {
+            Digit high = 0;
+            Digit low = digitMul(multiplier, y[j], high);
+            Digit newCarry = 0;
+            Digit acc = digitAdd(result[i + j], low, newCarry);
+            acc = digitAdd(acc, carry, newCarry);
+            result[i + j] = acc;
+            carry = high + newCarry;
+        }
+        result[i + yLength] = carry;
+    }
+}
+
+// Writes the {2 * length} digit product of {x} and {y}, both {length} digits
+// long, to {result}. With x = x1 * B^k + x0 and y = y1 * B^k + y0, the product is
+// z2 * B^2k + (z1 - z2 - z0) * B^k + z0 where z0 = x0 * y0, z2 = x1 * y1 and
+// z1 = (x0 + x1) * (y0 + y1), which takes three half-sized multiplications instead of four.
+void JSBigInt::multiplyKaratsuba(const Digit* x, const Digit* y, unsigned length, Digit* result)
+{
+    if (length < karatsubaThreshold) {
+        multiplyTextbook(x, length, y, length, result);
+        return;
+    }
+
+    unsigned lowLength = length / 2;
+    unsigned highLength = length - lowLength;
+
+    // z0 and z2 do not overlap, so they go straight into their final place.
+    multiplyKaratsuba(x, y, lowLength, result);
+    multiplyKaratsuba(x + lowLength, y + lowLength, highLength, result + 2 * lowLength);
+
+    unsigned sumLength = highLength + 1;
+    Vector<Digit> xSum(sumLength);
+    Vector<Digit> ySum(sumLength);
+    Vector<Digit> middle(2 * sumLength);
+    memcpy(xSum.data(), x + lowLength, highLength * sizeof(Digit));
+    memcpy(ySum.data(), y + lowLength, highLength * sizeof(Digit));
+    xSum[highLength] = 0;
+    ySum[highLength] = 0;
+    inplaceAddDigits(xSum.data(), sumLength, x, lowLength);
+    inplaceAddDigits(ySum.data(), sumLength, y, lowLength);
+
+    multiplyKaratsuba(xSum.data(), ySum.data(), sumLength, middle.data());
+    Digit borrow = inplaceSubDigits(middle.data(), middle.size(), result, 2 * lowLength);
+    borrow += inplaceSubDigits(middle.data(), middle.size(), result + 2 * lowLength, 2 * highLength);
+    ASSERT_UNUSED(borrow, !borrow);
+
+    // x0 * y1 + x1 * y0 always fits in {length + 1} digits.
+    unsigned middleLength = middle.size();
+    while (middleLength && !middle[middleLength - 1])
+        middleLength--;
+    ASSERT(middleLength <= 2 * length - lowLength);
+    Digit carry = inplaceAddDigits(result + lowLength, 2 * length - lowLength, middle.data(), middleLength);
+    ASSERT_UNUSED(carry, !carry);
+}
+
+// Adds {y} to {x} in place, where {yLength <= xLength}. Returns the carry out of {x}.
+JSBigInt::Digit JSBigInt::inplaceAddDigits(Digit* x, unsigned xLength, const Digit* y, unsigned yLength)
+{
+    ASSERT(yLength <= xLength);
+    Digit carry = 0;
+    unsigned i = 0;
+    for (; i < yLength; i++) {
+        Digit newCarry = 0;
+        Digit sum = digitAdd(x[i], y[i], newCarry);
+        x[i] = digitAdd(sum, carry, newCarry);
+        carry = newCarry;
+    }
+    for (; carry && i < xLength; i++) {
+        Digit newCarry = 0;
+        x[i] = digitAdd(x[i], carry, newCarry);
+        carry = newCarry;
+    }
+    return carry;
+}
+
+// Subtracts {y} from {x} in place, where {yLength <= xLength}. Returns the borrow out of {x}.
+JSBigInt::Digit JSBigInt::inplaceSubDigits(Digit* x, unsigned xLength, const Digit* y, unsigned yLength)
+{
+    ASSERT(yLength <= xLength);
+    Digit borrow = 0;
+    unsigned i = 0;
+    for (; i < yLength; i++) {
+        Digit newBorrow = 0;
+        Digit difference = digitSub(x[i], y[i], newBorrow);
+        x[i] = digitSub(difference, borrow, newBorrow);
+        borrow = newBorrow;
+    }
+    for (; borrow && i < xLength; i++) {
+        Digit newBorrow = 0;
+        x[i] = digitSub(x[i], borrow, newBorrow);
+        borrow = newBorrow;
+    }
+    return borrow;
+}
+
 bool JSBigInt::equals(JSBigInt* x, JSBigInt* y)
 {
     if (x->sign() != y->sign())
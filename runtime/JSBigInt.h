@@ -134,6 +134,14 @@ private:
     static void absoluteDivWithDigitDivisor(VM&, JSBigInt* x, Digit divisor, JSBigInt** quotient, Digit& remainder);
     static void internalMultiplyAdd(JSBigInt* source, Digit factor, Digit summand, unsigned, JSBigInt* result);
     static void multiplyAccumulate(JSBigInt* multiplicand, Digit multiplier, JSBigInt* accumulator, unsigned accumulatorIndex);
+
+    // Below this many digits in the shorter operand, schoolbook multiplication beats Karatsuba.
+    static constexpr unsigned karatsubaThreshold = 40;
+
+    static void multiplyTextbook(const Digit* x, unsigned xLength, const Digit* y, unsigned yLength, Digit* result);
+    static void multiplyKaratsuba(const Digit* x, const Digit* y, unsigned length, Digit* result);
+    static Digit inplaceAddDigits(Digit* x, unsigned xLength, const Digit* y, unsigned yLength);
+    static Digit inplaceSubDigits(Digit* x, unsigned xLength, const Digit* y, unsigned yLength);
     static void absoluteDivWithBigIntDivisor(VM&, JSBigInt* dividend, JSBigInt* divisor, JSBigInt** quotient, JSBigInt** remainder);
     
     enum class LeftShiftMode {
@@ -235,12 +235,107 @@ double parseDateFromNullTerminatedCharacters(VM& vm, const char* dateString)
     return localTimeMS - (offset * WTF::msPerMinute);
 }
 
+template<typename CharacterType>
+static inline bool readDigits(const CharacterType* characters, unsigned& index, unsigned count, int& result)
+{
+    result = 0;
+    for (unsigned end = index + count; index < end; ++index) {
+        if (!isASCIIDigit(characters[index]))
+            return false;
+        result = result * 10 + (characters[index] - '0');
+    }
+    return true;
+}
+
+static inline int daysInMonth(int year, int month)
+{
+    static const int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    if (month == 1 && isLeapYear(year))
+        return 29;
+    return days[month];
+}
+
+// Parses the common ISO 8601 / RFC 3339 forms directly from the string's characters:
+// YYYY-MM-DD, optionally followed by THH:mm, THH:mm:ss or THH:mm:ss.sss, and then by
+// Z or an offset of the form +HH:mm. Anything else, including expanded years and the
+// 24:00 end of day, returns NaN so the caller falls back to the general parsers.
+template<typename CharacterType>
+static double parseISODateTime(const CharacterType* characters, unsigned length)
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    unsigned index = 0;
+    int year, month, day;
+    if (length < 10
+        || !readDigits(characters, index, 4, year) || characters[index++] != '-'
+        || !readDigits(characters, index, 2, month) || characters[index++] != '-'
+        || !readDigits(characters, index, 2, day))
+        return nan;
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month - 1))
+        return nan;
+
+    double result = dateToDaysFrom1970(year, month - 1, day) * msPerDay;
+    // Date-only forms are UTC.
+    if (index == length)
+        return result;
+
+    int hour, minute;
+    int second = 0;
+    int milliseconds = 0;
+    if (length < index + 6 || characters[index++] != 'T'
+        || !readDigits(characters, index, 2, hour) || characters[index++] != ':'
+        || !readDigits(characters, index, 2, minute))
+        return nan;
+    if (index < length && characters[index] == ':') {
+        ++index;
+        if (length < index + 2 || !readDigits(characters, index, 2, second))
+            return nan;
+        if (index < length && characters[index] == '.') {
+            ++index;
+            if (length < index + 3 || !readDigits(characters, index, 3, milliseconds))
+                return nan;
+        }
+    }
+    if (hour > 23 || minute > 59 || second > 59)
+        return nan;
+    result += timeToMS(hour, minute, second, milliseconds);
+
+    // Like parseES5DateFromNullTerminatedCharacters, treat a missing offset as UTC.
+    if (index == length)
+        return result;
+
+    if (characters[index] == 'Z')
+        return index + 1 == length ? result : nan;
+
+    if (characters[index] != '+' && characters[index] != '-')
+        return nan;
+    int sign = characters[index++] == '-' ? -1 : 1;
+    int offsetHours, offsetMinutes;
+    if (length != index + 5
+        || !readDigits(characters, index, 2, offsetHours) || characters[index++] != ':'
+        || !readDigits(characters, index, 2, offsetMinutes))
+        return nan;
+    if (offsetHours > 23 || offsetMinutes > 59)
+        return nan;
+    return result - sign * (offsetHours * minutesPerHour + offsetMinutes) * msPerMinute;
+}
+
 double parseDate(ExecState* exec, VM& vm, const String& date)
 {
     auto scope = DECLARE_THROW_SCOPE(vm);
 
     if (date == vm.cachedDateString)
         return vm.cachedDateStringValue;
+
+    double fastValue = date.is8Bit()
+        ? parseISODateTime(date.characters8(), date.length())
+        : parseISODateTime(date.characters16(), date.length());
+    if (!std::isnan(fastValue)) {
+        vm.cachedDateString = date;
+        vm.cachedDateStringValue = fastValue;
+        return fastValue;
+    }
+
     auto expectedString = date.tryGetUtf8();
     if (!expectedString) {
         if (expectedString.error() == UTF8ConversionError::OutOfMemory)
@@ -28,6 +28,7 @@
 #include "JSArrayBufferView.h"
 #include "ThrowScope.h"
 #include "ToNativeFromValue.h"
+#include <array>
 
 namespace JSC {
 
@@ -194,6 +195,9 @@ public:
     void sort()
     {
         RELEASE_ASSERT(!isNeutered());
+        if (m_length >= radixSortThreshold && radixSort())
+            return;
+
         switch (Adaptor::typeValue) {
         case TypeFloat32:
             sortFloat<int32_t>();
@@ -348,6 +352,76 @@ private:
 
     }
 
+    // Large arrays are sorted with an LSD radix sort over unsigned keys whose order matches
+    // the order of the elements: signed integers get their sign bit flipped, and floats get
+    // the sign bit flipped when positive and every bit flipped when negative. As with
+    // sortFloat(), NaNs are purified first so that they sort last. The sort needs a scratch buffer
+    // as large as the array; if that cannot be allocated, sort() falls back to sorting in place.
+    static constexpr unsigned radixSortThreshold = 512;
+    using RadixKey = typename std::conditional<sizeof(ElementType) == 1, uint8_t,
+        typename std::conditional<sizeof(ElementType) == 2, uint16_t,
+        typename std::conditional<sizeof(ElementType) == 4, uint32_t, uint64_t>::type>::type>::type;
+    static constexpr RadixKey radixSignBit = static_cast<RadixKey>(1) << (sizeof(RadixKey) * 8 - 1);
+
+    static RadixKey toRadixKey(RadixKey bits)
+    {
+        if (Adaptor::typeValue == TypeFloat32 || Adaptor::typeValue == TypeFloat64)
+            return (bits & radixSignBit) ? static_cast<RadixKey>(~bits) : static_cast<RadixKey>(bits | radixSignBit);
+        if (std::is_signed<ElementType>::value)
+            return bits ^ radixSignBit;
+        return bits;
+    }
+
+    static RadixKey fromRadixKey(RadixKey key)
+    {
+        if (Adaptor::typeValue == TypeFloat32 || Adaptor::typeValue == TypeFloat64)
+            return (key & radixSignBit) ? static_cast<RadixKey>(key ^ radixSignBit) : static_cast<RadixKey>(~key);
+        if (std::is_signed<ElementType>::value)
+            return key ^ radixSignBit;
+        return key;
+    }
+
+    bool radixSort()
+    {
+        unsigned length = m_length;
+        Vector<RadixKey> buffer;
+        if (UNLIKELY(!buffer.tryReserveCapacity(length)))
+            return false;
+        buffer.grow(length);
+
+        if (Adaptor::typeValue == TypeFloat32 || Adaptor::typeValue == TypeFloat64)
+            purifyArray();
+
+        RadixKey* keys = reinterpret_cast_ptr<RadixKey*>(typedVector());
+        for (unsigned i = 0; i < length; ++i)
+            keys[i] = toRadixKey(keys[i]);
+
+        RadixKey* source = keys;
+        RadixKey* destination = buffer.data();
+        for (unsigned shift = 0; shift < sizeof(RadixKey) * 8; shift += 8) {
+            std::array<unsigned, 256> counts { };
+            for (unsigned i = 0; i < length; ++i)
+                counts[(source[i] >> shift) & 0xff]++;
+            // Every key has the same byte here, so this pass would not move anything.
+            if (counts[(source[0] >> shift) & 0xff] == length)
+                continue;
+
+            unsigned offset = 0;
+            for (unsigned& count : counts) {
+                unsigned bucketSize = count;
+                count = offset;
+                offset += bucketSize;
+            }
+            for (unsigned i = 0; i < length; ++i)
+                destination[counts[(source[i] >> shift) & 0xff]++] = source[i];
+            std::swap(source, destination);
+        }
+
+        for (unsigned i = 0; i < length; ++i)
+            keys[i] = fromRadixKey(source[i]);
+        return true;
+    }
+
 };
 
 template<typename Adaptor>
@@ -39,10 +39,15 @@ namespace JSC {
 
 class JSJobMicrotask final : public Microtask {
 public:
-    JSJobMicrotask(VM& vm, JSValue job, JSArray* arguments)
+    static const unsigned maxArguments = 3;
+
+    JSJobMicrotask(VM& vm, JSValue job, const ArgList& arguments)
+        : m_argumentCount(arguments.size())
     {
+        RELEASE_ASSERT(m_argumentCount <= maxArguments);
         m_job.set(vm, job);
-        m_arguments.set(vm, arguments);
+        for (unsigned index = 0; index < m_argumentCount; ++index)
+            m_arguments[index].set(vm, arguments.at(index));
     }
 
     virtual ~JSJobMicrotask()
@@ -53,10 +58,13 @@ private:
     void run(ExecState*) override;
 
     Strong<Unknown> m_job;
-    Strong<JSArray> m_arguments;
+    // Promise jobs take at most three arguments, so we keep them inline rather than
+    // allocating a JSArray for every reaction.
+    Strong<Unknown> m_arguments[maxArguments];
+    unsigned m_argumentCount;
 };
 
-Ref<Microtask> createJSJob(VM& vm, JSValue job, JSArray* arguments)
+Ref<Microtask> createJSJob(VM& vm, JSValue job, const ArgList& arguments)
 {
     return adoptRef(*new JSJobMicrotask(vm, job, arguments));
 }
@@ -71,13 +79,9 @@ void JSJobMicrotask::run(ExecState* exec)
     ASSERT(handlerCallType != CallType::None);
 
     MarkedArgumentBuffer handlerArguments;
-    for (unsigned index = 0, length = m_arguments->length(); index < length; ++index) {
-        JSValue arg = m_arguments->JSArray::get(exec, index);
-        CLEAR_AND_RETURN_IF_EXCEPTION(scope, handlerArguments.overflowCheckNotNeeded());
-        handlerArguments.append(arg);
-    }
-    if (UNLIKELY(handlerArguments.hasOverflowed()))
-        return;
+    for (unsigned index = 0; index < m_argumentCount; ++index)
+        handlerArguments.append(m_arguments[index].get());
+    ASSERT(!handlerArguments.hasOverflowed());
     profiledCall(exec, ProfilingReason::Microtask, m_job.get(), handlerCallType, handlerCallData, jsUndefined(), handlerArguments);
     scope.clearException();
 }
@@ -30,9 +30,9 @@
 
 namespace JSC {
 
+class ArgList;
 class Microtask;
-class JSArray;
 
-Ref<Microtask> createJSJob(VM&, JSValue job, JSArray* arguments);
+Ref<Microtask> createJSJob(VM&, JSValue job, const ArgList& arguments);
 
 } // namespace JSC
@@ -37,6 +37,7 @@
 #include "ObjectConstructor.h"
 #include "JSCInlines.h"
 #include "PropertyNameArray.h"
+#include "StringKernels.h"
 #include <wtf/MathExtras.h>
 #include <wtf/text/StringBuilder.h>
 
@@ -106,6 +107,8 @@ private:
         unsigned m_index;
         unsigned m_size;
         RefPtr<PropertyNameArrayData> m_propertyNames;
+        RefPtr<CachedJSONPropertyList> m_cachedPropertyList;
+        StructureID m_structureID { 0 };
     };
 
     friend class Holder;
@@ -137,6 +140,44 @@ private:
 
 // ------------------------------ helper functions --------------------------------
 
+static ALWAYS_INLINE bool appendQuotedJSONString(StringBuilder& builder, const String& string)
+{
+    // Most strings need no escaping at all. Find that out 16 bytes at a time and copy them
+    // straight into the builder.
+    unsigned length = string.length();
+    bool isPlain = string.is8Bit()
+        ? StringKernels::countPlainJSONStringCharacters(string.characters8(), length, static_cast<LChar>('"')) == length
+        : StringKernels::countPlainJSONStringCharacters(string.characters16(), length, static_cast<UChar>('"')) == length;
+    if (!isPlain || static_cast<uint64_t>(builder.length()) + length + 2 > JSString::MaxLength)
+        return builder.appendQuotedJSONString(string);
+    builder.append('"');
+    builder.append(string);
+    builder.append('"');
+    return true;
+}
+
+// Plain objects whose properties are all plain data properties of a non-dictionary
+// Structure can be serialized from a per-Structure list of names, offsets and pre-quoted keys.
+static RefPtr<CachedJSONPropertyList> cachedJSONPropertyListFor(VM& vm, JSObject* object)
+{
+    Structure* structure = object->structure(vm);
+    if (structure->typeInfo().type() != FinalObjectType
+        || structure->isDictionary()
+        || hasIndexedProperties(structure->indexingType())
+        || structure->hasGetterSetterProperties()
+        || structure->hasCustomGetterSetterProperties()
+        || structure->typeInfo().overridesGetOwnPropertySlot()
+        || structure->typeInfo().overridesGetPropertyNames())
+        return nullptr;
+
+    if (CachedJSONPropertyList* propertyList = structure->cachedJSONPropertyList())
+        return propertyList;
+
+    auto propertyList = CachedJSONPropertyList::create(vm, structure);
+    structure->setCachedJSONPropertyList(vm, propertyList.copyRef());
+    return WTFMove(propertyList);
+}
+
 static inline JSValue unwrapBoxedPrimitive(ExecState* exec, JSValue value)
 {
     VM& vm = exec->vm();
@@ -357,7 +398,7 @@ Stringifier::StringifyResult Stringifier::appendStringifiedValue(StringBuilder&
     if (value.isString()) {
         const String& string = asString(value)->value(m_exec);
         RETURN_IF_EXCEPTION(scope, StringifyFailed);
-        if (builder.appendQuotedJSONString(string))
+        if (appendQuotedJSONString(builder, string))
             return StringifySucceeded;
         throwOutOfMemoryError(m_exec, scope);
         return StringifyFailed;
@@ -487,13 +528,15 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBui
         } else {
             if (stringifier.m_usingArrayReplacer)
                 m_propertyNames = stringifier.m_arrayReplacerPropertyNames.data();
+            else if ((m_cachedPropertyList = cachedJSONPropertyListFor(vm, m_object)))
+                m_structureID = m_object->structureID();
             else {
                 PropertyNameArray objectPropertyNames(&vm, PropertyNameMode::Strings, PrivateSymbolMode::Exclude);
                 m_object->methodTable(vm)->getOwnPropertyNames(m_object, exec, objectPropertyNames, EnumerationMode());
                 RETURN_IF_EXCEPTION(scope, false);
                 m_propertyNames = objectPropertyNames.releaseData();
             }
-            m_size = m_propertyNames->propertyNameVector().size();
+            m_size = m_cachedPropertyList ? m_cachedPropertyList->entries().size() : m_propertyNames->propertyNameVector().size();
             builder.append('{');
         }
         stringifier.indent();
@@ -534,6 +577,35 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBui
         // Append the stringified value.
         stringifyResult = stringifier.appendStringifiedValue(builder, value, *this, index);
         ASSERT(stringifyResult != StringifyFailedDueToUndefinedOrSymbolValue);
+    } else if (m_cachedPropertyList) {
+        // Get the value. If a toJSON or replacer call changed the object's Structure, the
+        // cached offsets no longer apply, so fall back to a regular [[Get]].
+        const CachedJSONPropertyList::Entry& entry = m_cachedPropertyList->entries()[index];
+        JSValue value;
+        if (LIKELY(m_object->structureID() == m_structureID))
+            value = m_object->getDirect(entry.offset);
+        else {
+            PropertySlot slot(m_object, PropertySlot::InternalMethodType::Get);
+            if (!m_object->methodTable(vm)->getOwnPropertySlot(m_object, exec, entry.name, slot))
+                return true;
+            value = slot.getValue(exec, entry.name);
+            RETURN_IF_EXCEPTION(scope, false);
+        }
+
+        rollBackPoint = builder.length();
+
+        // Append the separator string.
+        if (builder[rollBackPoint - 1] != '{')
+            builder.append(',');
+        stringifier.startNewLine(builder);
+
+        // Append the pre-quoted property name and colon.
+        builder.append(entry.quotedName);
+        if (stringifier.willIndent())
+            builder.append(' ');
+
+        // Append the stringified value.
+        stringifyResult = stringifier.appendStringifiedValue(builder, value, *this, entry.name);
     } else {
         // Get the value.
         PropertySlot slot(m_object, PropertySlot::InternalMethodType::Get);
@@ -582,6 +654,26 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBui
     return true;
 }
 
+// ------------------------------ CachedJSONPropertyList --------------------------------
+
+Ref<CachedJSONPropertyList> CachedJSONPropertyList::create(VM& vm, Structure* structure)
+{
+    ASSERT(!structure->isDictionary());
+    Ref<CachedJSONPropertyList> propertyList = adoptRef(*new CachedJSONPropertyList);
+    structure->forEachProperty(vm, [&] (const PropertyMapEntry& entry) -> bool {
+        if ((entry.attributes & PropertyAttribute::DontEnum) || entry.key->isSymbol())
+            return true;
+        Identifier name = Identifier::fromUid(&vm, entry.key);
+        StringBuilder quotedName;
+        quotedName.appendQuotedJSONString(name.string());
+        quotedName.append(':');
+        propertyList->m_entries.append({ WTFMove(name), entry.offset, quotedName.toString() });
+        return true;
+    });
+    propertyList->m_entries.shrinkToFit();
+    return propertyList;
+}
+
 // ------------------------------ JSONObject --------------------------------
 
 const ClassInfo JSONObject::s_info = { "JSON", &JSNonFinalObject::s_info, &jsonTable, nullptr, CREATE_METHOD_TABLE(JSONObject) };
@@ -55,6 +55,26 @@ private:
     JSONObject(VM&, Structure*);
 };
 
+// The enumerable string-keyed properties of a non-dictionary Structure, in enumeration order, along
+// with each name already quoted for JSON output. Cached on the Structure's rare data by JSON.stringify.
+class CachedJSONPropertyList : public RefCounted<CachedJSONPropertyList> {
+public:
+    struct Entry {
+        Identifier name;
+        PropertyOffset offset;
+        String quotedName;
+    };
+
+    static Ref<CachedJSONPropertyList> create(VM&, Structure*);
+
+    const Vector<Entry>& entries() const { return m_entries; }
+
+private:
+    CachedJSONPropertyList() = default;
+
+    Vector<Entry> m_entries;
+};
+
 JS_EXPORT_PRIVATE JSValue JSONParse(ExecState*, const String&);
 JS_EXPORT_PRIVATE String JSONStringify(ExecState*, JSValue, unsigned indent);
     
@@ -34,6 +34,7 @@
 #include "Lexer.h"
 #include "ObjectConstructor.h"
 #include "JSCInlines.h"
+#include "StringKernels.h"
 #include "StrongInlines.h"
 #include <wtf/ASCIICType.h>
 #include <wtf/dtoa.h>
@@ -439,8 +440,8 @@ ALWAYS_INLINE TokenType LiteralParser<CharType>::Lexer::lex(LiteralParserToken<C
     m_currentTokenID++;
 #endif
 
-    while (m_ptr < m_end && isJSONWhiteSpace(*m_ptr))
-        ++m_ptr;
+    if (m_ptr < m_end && isJSONWhiteSpace(*m_ptr))
+        m_ptr += StringKernels::countJSONWhiteSpace(m_ptr, m_end - m_ptr);
 
     ASSERT(m_ptr <= m_end);
     if (m_ptr == m_end) {
@@ -588,8 +589,7 @@ ALWAYS_INLINE TokenType LiteralParser<CharType>::Lexer::lexString(LiteralParserT
     const CharType* runStart = m_ptr;
 
     if (m_mode == StrictJSON) {
-        while (m_ptr < m_end && isSafeStringCharacter<SafeStringCharacterSet::Strict>(*m_ptr, terminator))
-            ++m_ptr;
+        m_ptr += StringKernels::countPlainJSONStringCharacters(m_ptr, m_end - m_ptr, terminator);
     } else {
         while (m_ptr < m_end && isSafeStringCharacter<SafeStringCharacterSet::NonStrict>(*m_ptr, terminator))
             ++m_ptr;
@@ -613,8 +613,7 @@ TokenType LiteralParser<CharType>::Lexer::lexStringSlow(LiteralParserToken<CharT
     do {
         runStart = m_ptr;
         if (m_mode == StrictJSON) {
-            while (m_ptr < m_end && isSafeStringCharacter<SafeStringCharacterSet::Strict>(*m_ptr, terminator))
-                ++m_ptr;
+            m_ptr += StringKernels::countPlainJSONStringCharacters(m_ptr, m_end - m_ptr, terminator);
         } else {
             while (m_ptr < m_end && isSafeStringCharacter<SafeStringCharacterSet::NonStrict>(*m_ptr, terminator))
                 ++m_ptr;
@@ -814,6 +813,104 @@ TokenType LiteralParser<CharType>::Lexer::lexNumber(LiteralParserToken<CharType>
     return TokNumber;
 }
 
+template <typename CharType>
+JSValue LiteralParser<CharType>::constructObject(MarkedArgumentBuffer& values, IdentifierStack& identifiers, unsigned valuesStart)
+{
+    VM& vm = m_exec->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    unsigned propertyCount = values.size() - valuesStart;
+    unsigned identifiersStart = identifiers.size() - propertyCount;
+    ASSERT(propertyCount);
+
+    auto popProperties = [&] {
+        for (unsigned i = 0; i < propertyCount; ++i)
+            values.removeLast();
+        identifiers.shrink(identifiersStart);
+    };
+
+    unsigned hash = 0;
+    for (unsigned i = 0; i < propertyCount; ++i)
+        hash = WTF::pairIntHash(hash, identifiers[identifiersStart + i].impl()->hash());
+    if (!m_objectShapeCache)
+        m_objectShapeCache = std::make_unique<std::array<CachedObjectShape, ObjectShapeCacheSize>>();
+    CachedObjectShape& shape = (*m_objectShapeCache)[hash % ObjectShapeCacheSize];
+
+    bool shapeMatches = shape.structure.get() && shape.propertyNames.size() == propertyCount;
+    for (unsigned i = 0; shapeMatches && i < propertyCount; ++i)
+        shapeMatches = shape.propertyNames[i].impl() == identifiers[identifiersStart + i].impl();
+
+    if (shapeMatches) {
+        Structure* structure = shape.structure.get();
+        for (unsigned i = 0; i < propertyCount; ++i)
+            structure->willStoreValueForExistingTransition(vm, identifiers[identifiersStart + i], values.at(valuesStart + i), false);
+
+        JSObject* object;
+        if (unsigned outOfLineCapacity = structure->outOfLineCapacity()) {
+            // Clear the out-of-line slots before the object is published, so the concurrent
+            // marker never scans uninitialized values. Inline storage is cleared by JSFinalObject.
+            Butterfly* butterfly = Butterfly::create(vm, nullptr, 0, outOfLineCapacity, false, IndexingHeader(), 0);
+            for (unsigned i = 0; i < outOfLineCapacity; ++i)
+                butterfly->propertyStorage()[-static_cast<int>(i) - 1].clear();
+            object = JSFinalObject::create(m_exec, structure, butterfly);
+        } else
+            object = constructEmptyObject(m_exec, structure);
+        for (unsigned i = 0; i < propertyCount; ++i)
+            object->putDirect(vm, shape.offsets[i], values.at(valuesStart + i));
+        popProperties();
+        return object;
+    }
+
+    JSObject* object = constructEmptyObject(m_exec);
+    bool isCacheable = true;
+    bool sawUnderscoreProto = false;
+    for (unsigned i = 0; i < propertyCount; ++i) {
+        const Identifier& ident = identifiers[identifiersStart + i];
+        JSValue value = values.at(valuesStart + i);
+        if (m_mode != StrictJSON && ident == vm.propertyNames->underscoreProto) {
+            if (sawUnderscoreProto) {
+                m_parseErrorMessage = "Attempted to redefine __proto__ property"_s;
+                return JSValue();
+            }
+            sawUnderscoreProto = true;
+            isCacheable = false;
+            CodeBlock* codeBlock = m_exec->codeBlock();
+            PutPropertySlot slot(object, codeBlock ? codeBlock->isStrictMode() : false);
+            JSValue(object).put(m_exec, ident, value, slot);
+        } else if (std::optional<uint32_t> index = parseIndex(ident)) {
+            isCacheable = false;
+            object->putDirectIndex(m_exec, index.value(), value);
+        } else
+            object->putDirect(vm, ident, value);
+        RETURN_IF_EXCEPTION(scope, JSValue());
+    }
+
+    Structure* structure = object->structure(vm);
+    if (isCacheable && !structure->isDictionary()) {
+        // Duplicate property names collapse into a single property, in which case the offsets
+        // are not the dense sequence that a fresh transition chain produces.
+        Vector<PropertyOffset, 8> offsets;
+        offsets.reserveInitialCapacity(propertyCount);
+        for (unsigned i = 0; i < propertyCount; ++i) {
+            PropertyOffset offset = structure->get(vm, identifiers[identifiersStart + i]);
+            if (offset != offsetForPropertyNumber(i, structure->inlineCapacity())) {
+                isCacheable = false;
+                break;
+            }
+            offsets.uncheckedAppend(offset);
+        }
+        if (isCacheable) {
+            shape.structure.set(vm, structure);
+            shape.propertyNames.clear();
+            shape.propertyNames.append(identifiers.data() + identifiersStart, propertyCount);
+            shape.offsets = WTFMove(offsets);
+        }
+    }
+
+    popProperties();
+    return object;
+}
+
 template <typename CharType>
 JSValue LiteralParser<CharType>::parse(ParserState initialState)
 {
@@ -823,8 +920,10 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
     MarkedArgumentBuffer objectStack;
     JSValue lastValue;
     Vector<ParserState, 16, UnsafeVectorOverflow> stateStack;
-    Vector<Identifier, 16, UnsafeVectorOverflow> identifierStack;
-    HashSet<JSObject*> visitedUnderscoreProto;
+    IdentifierStack identifierStack;
+    // Property values of the objects being parsed are kept in objectStack until the closing
+    // brace; this records where the values of each open object start.
+    Vector<unsigned, 16, UnsafeVectorOverflow> objectValuesStartStack;
     while (1) {
         switch(state) {
             startParseArray:
@@ -869,8 +968,7 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
             }
             startParseObject:
             case StartParseObject: {
-                JSObject* object = constructEmptyObject(m_exec);
-                objectStack.appendWithCrashOnOverflow(object);
+                objectValuesStartStack.append(objectStack.size());
 
                 TokenType type = m_lexer.next();
                 if (type == TokString || (m_mode != StrictJSON && type == TokIdentifier)) {
@@ -895,7 +993,8 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
                     return JSValue();
                 }
                 m_lexer.next();
-                lastValue = objectStack.takeLast();
+                objectValuesStartStack.removeLast();
+                lastValue = constructEmptyObject(m_exec);
                 break;
             }
             doParseObjectStartExpression:
@@ -923,23 +1022,7 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
             }
             case DoParseObjectEndExpression:
             {
-                JSObject* object = asObject(objectStack.last());
-                Identifier ident = identifierStack.takeLast();
-                if (m_mode != StrictJSON && ident == vm.propertyNames->underscoreProto) {
-                    if (!visitedUnderscoreProto.add(object).isNewEntry) {
-                        m_parseErrorMessage = "Attempted to redefine __proto__ property"_s;
-                        return JSValue();
-                    }
-                    CodeBlock* codeBlock = m_exec->codeBlock();
-                    PutPropertySlot slot(object, codeBlock ? codeBlock->isStrictMode() : false);
-                    objectStack.last().put(m_exec, ident, lastValue, slot);
-                } else {
-                    if (std::optional<uint32_t> index = parseIndex(ident))
-                        object->putDirectIndex(m_exec, index.value(), lastValue);
-                    else
-                        object->putDirect(vm, ident, lastValue);
-                }
-                RETURN_IF_EXCEPTION(scope, JSValue());
+                objectStack.appendWithCrashOnOverflow(lastValue);
                 if (m_lexer.currentToken()->type == TokComma)
                     goto doParseObjectStartExpression;
                 if (m_lexer.currentToken()->type != TokRBrace) {
@@ -947,7 +1030,10 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
                     return JSValue();
                 }
                 m_lexer.next();
-                lastValue = objectStack.takeLast();
+                lastValue = constructObject(objectStack, identifierStack, objectValuesStartStack.takeLast());
+                RETURN_IF_EXCEPTION(scope, JSValue());
+                if (!lastValue)
+                    return JSValue();
                 break;
             }
             startParseExpression:
@@ -27,12 +27,17 @@
 
 #include "Identifier.h"
 #include "JSCJSValue.h"
+#include "PropertyOffset.h"
+#include "Strong.h"
 #include <array>
 #include <wtf/text/StringBuilder.h>
 #include <wtf/text/WTFString.h>
 
 namespace JSC {
 
+class MarkedArgumentBuffer;
+class Structure;
+
 typedef enum { StrictJSON, NonStrictJSON, JSONP } ParserMode;
 
 enum JSONPPathEntryType {
@@ -190,6 +195,9 @@ private:
     class StackGuard;
     JSValue parse(ParserState);
 
+    typedef Vector<Identifier, 16, UnsafeVectorOverflow> IdentifierStack;
+    JSValue constructObject(MarkedArgumentBuffer& values, IdentifierStack&, unsigned valuesStart);
+
     ExecState* m_exec;
     typename LiteralParser<CharType>::Lexer m_lexer;
     ParserMode m_mode;
@@ -199,6 +207,21 @@ private:
     std::array<Identifier, MaximumCachableCharacter> m_recentIdentifiers;
     ALWAYS_INLINE const Identifier makeIdentifier(const LChar* characters, size_t length);
     ALWAYS_INLINE const Identifier makeIdentifier(const UChar* characters, size_t length);
+
+    // Remembers the Structure (and the offset of each property) that a plain object ended up
+    // with for a given sequence of property names. JSON payloads tend to repeat the same object
+    // shapes, so later objects with that sequence can be allocated directly with the final
+    // Structure. The object a Structure was cached from may become garbage before the parse ends,
+    // e.g. when a duplicate key overwrites it, so the cache holds the Structures strongly. The
+    // cache is allocated when the first object is constructed, so parses that never build an
+    // object do not pay for it.
+    struct CachedObjectShape {
+        Strong<Structure> structure;
+        Vector<Identifier, 8> propertyNames;
+        Vector<PropertyOffset, 8> offsets;
+    };
+    static unsigned const ObjectShapeCacheSize = 64;
+    std::unique_ptr<std::array<CachedObjectShape, ObjectShapeCacheSize>> m_objectShapeCache;
 };
 
 } // namespace JSC
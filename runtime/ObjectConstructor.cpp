@@ -30,6 +30,7 @@
 #include "JSFunction.h"
 #include "JSGlobalObject.h"
 #include "JSGlobalObjectFunctions.h"
+#include "JSImmutableButterfly.h"
 #include "Lookup.h"
 #include "ObjectPrototype.h"
 #include "PropertyDescriptor.h"
@@ -278,7 +279,6 @@ EncodedJSValue JSC_HOST_CALL objectConstructorGetOwnPropertySymbols(ExecState* e
     return JSValue::encode(ownPropertyKeys(exec, object, PropertyNameMode::Symbols, DontEnumPropertiesMode::Include));
 }
 
-// FIXME: Use the enumeration cache.
 EncodedJSValue JSC_HOST_CALL objectConstructorKeys(ExecState* exec)
 {
     VM& vm = exec->vm();
@@ -289,6 +289,50 @@ EncodedJSValue JSC_HOST_CALL objectConstructorKeys(ExecState* exec)
     return JSValue::encode(ownPropertyKeys(exec, object, PropertyNameMode::Strings, DontEnumPropertiesMode::Exclude));
 }
 
+// If |target| is an empty plain object and |source|'s Structure was built from |target|'s by only
+// adding plain data properties, copying every property over would walk |target| through the same
+// transitions. Instead, give |target| the final Structure and copy the property storage.
+// Callers must check anything about |target|'s prototype chain that matters to them.
+static bool tryCopyPropertiesByCloningStructure(VM& vm, JSObject* target, JSObject* source)
+{
+    Structure* targetStructure = target->structure(vm);
+    Structure* sourceStructure = source->structure(vm);
+    if (targetStructure->typeInfo().type() != FinalObjectType || sourceStructure->typeInfo().type() != FinalObjectType)
+        return false;
+    if (!targetStructure->isEmpty() || target->butterfly() || hasIndexedProperties(sourceStructure->indexingType()))
+        return false;
+    if (sourceStructure == targetStructure)
+        return true;
+    if (sourceStructure->hasUnderscoreProtoPropertyExcludingOriginalProto() || !sourceStructure->isPlainPropertyAdditionDescendantOf(targetStructure))
+        return false;
+
+    unsigned inlineCapacity = sourceStructure->inlineCapacity();
+    unsigned propertyCount = sourceStructure->totalStorageSize();
+    ASSERT(targetStructure->inlineCapacity() == inlineCapacity);
+
+    // Like putDirectInternal(), make room before the structure says that the properties exist.
+    if (unsigned outOfLineCapacity = sourceStructure->outOfLineCapacity()) {
+        Butterfly* butterfly = target->allocateMoreOutOfLineStorage(vm, 0, outOfLineCapacity);
+        target->nukeStructureAndSetButterfly(vm, target->structureID(), butterfly);
+    }
+    for (unsigned i = 0; i < propertyCount; ++i) {
+        PropertyOffset offset = offsetForPropertyNumber(i, inlineCapacity);
+        target->putDirect(vm, offset, source->getDirect(offset));
+    }
+    target->setStructure(vm, sourceStructure);
+    return true;
+}
+
+EncodedJSValue JSC_HOST_CALL objectConstructorPrivateFuncCopyDataPropertiesByCloningStructure(ExecState* exec)
+{
+    VM& vm = exec->vm();
+    ASSERT(exec->argument(0).isObject() && exec->argument(1).isObject());
+    JSObject* target = asObject(exec->uncheckedArgument(0));
+    JSObject* source = asObject(exec->uncheckedArgument(1));
+    // Spread defines properties rather than putting them, so |target|'s prototype chain does not matter.
+    return JSValue::encode(jsBoolean(tryCopyPropertiesByCloningStructure(vm, target, source)));
+}
+
 EncodedJSValue JSC_HOST_CALL objectConstructorAssign(ExecState* exec)
 {
     VM& vm = exec->vm();
@@ -313,6 +357,9 @@ EncodedJSValue JSC_HOST_CALL objectConstructorAssign(ExecState* exec)
         RETURN_IF_EXCEPTION(scope, { });
 
         if (targetCanPerformFastPut) {
+            if (tryCopyPropertiesByCloningStructure(vm, target, source))
+                continue;
+
             if (!source->staticPropertiesReified(vm)) {
                 source->reifyAllStaticProperties(exec);
                 RETURN_IF_EXCEPTION(scope, { });
@@ -903,11 +950,29 @@ EncodedJSValue JSC_HOST_CALL objectConstructorIs(ExecState* exec)
     return JSValue::encode(jsBoolean(sameValue(exec, exec->argument(0), exec->argument(1))));
 }
 
-// FIXME: Use the enumeration cache.
+static JSArray* createArrayFromCachedOwnKeys(VM& vm, JSGlobalObject* globalObject, JSImmutableButterfly* ownKeys)
+{
+    Structure* structure = globalObject->originalArrayStructureForIndexingType(CopyOnWriteArrayWithContiguous);
+    return JSArray::createWithButterfly(vm, nullptr, structure, ownKeys->toButterfly());
+}
+
 JSArray* ownPropertyKeys(ExecState* exec, JSObject* object, PropertyNameMode propertyNameMode, DontEnumPropertiesMode dontEnumPropertiesMode)
 {
     VM& vm = exec->vm();
     auto scope = DECLARE_THROW_SCOPE(vm);
+
+    // Objects that share a plain Structure have the same own string keys, so Object.keys() and
+    // Object.getOwnPropertyNames() hand out copy-on-write arrays of a list cached on the Structure.
+    JSGlobalObject* lexicalGlobalObject = exec->lexicalGlobalObject();
+    Structure* structure = object->structure(vm);
+    bool canUseOwnKeysCache = propertyNameMode == PropertyNameMode::Strings
+        && structure->canCacheOwnKeys()
+        && !lexicalGlobalObject->isHavingABadTime();
+    if (canUseOwnKeysCache) {
+        if (JSImmutableButterfly* ownKeys = structure->cachedOwnKeys(dontEnumPropertiesMode))
+            return createArrayFromCachedOwnKeys(vm, lexicalGlobalObject, ownKeys);
+    }
+
     PropertyNameArray properties(&vm, propertyNameMode, PrivateSymbolMode::Exclude);
     object->methodTable(vm)->getOwnPropertyNames(object, exec, properties, EnumerationMode(dontEnumPropertiesMode));
     RETURN_IF_EXCEPTION(scope, nullptr);
@@ -932,6 +997,14 @@ JSArray* ownPropertyKeys(ExecState* exec, JSObject* object, PropertyNameMode pro
             auto* globalObject = exec->lexicalGlobalObject();
             if (LIKELY(!globalObject->isHavingABadTime())) {
                 size_t numProperties = properties.size();
+                if (canUseOwnKeysCache && object->structure(vm) == structure) {
+                    JSImmutableButterfly* ownKeys = JSImmutableButterfly::create(vm, CopyOnWriteArrayWithContiguous, numProperties);
+                    for (size_t i = 0; i < numProperties; i++)
+                        ownKeys->setIndex(vm, i, jsOwnedString(&vm, properties[i].string()));
+                    structure->setCachedOwnKeys(vm, dontEnumPropertiesMode, ownKeys);
+                    return createArrayFromCachedOwnKeys(vm, globalObject, ownKeys);
+                }
+
                 JSArray* keys = JSArray::create(vm, globalObject->originalArrayStructureForIndexingType(ArrayWithContiguous), numProperties);
                 WriteBarrier<Unknown>* buffer = keys->butterfly()->contiguous().data();
                 for (size_t i = 0; i < numProperties; i++) {
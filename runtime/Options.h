@@ -495,17 +495,23 @@ constexpr bool enableWebAssemblyStreamingApi = false;
     v(unsigned, webAssemblyOMGTierUpCount, 5000, Normal, "The countdown before we tier up a function to OMG.") \
     v(unsigned, webAssemblyLoopDecrement, 15, Normal, "The amount the tier up countdown is decremented on each loop backedge.") \
     v(unsigned, webAssemblyFunctionEntryDecrement, 1, Normal, "The amount the tier up countdown is decremented on each function entry.") \
+    v(bool, useWebAssemblyOSR, true, Normal, "If true, BBQ code running a hot loop enters OMG code compiled to start at that loop.") \
     \
     /* FIXME: enable fast memories on iOS and pre-allocate them. https://bugs.webkit.org/show_bug.cgi?id=170774 */ \
     v(bool, useWebAssemblyFastMemory, !isIOS(), Normal, "If true, we will try to use a 32-bit address space with a signal handler to bounds check wasm memory.") \
     v(bool, logWebAssemblyMemory, false, Normal, nullptr) \
     v(unsigned, webAssemblyFastMemoryRedzonePages, 128, Normal, "WebAssembly fast memories use 4GiB virtual allocations, plus a redzone (counted as multiple of 64KiB WebAssembly pages) at the end to catch reg+imm accesses which exceed 32-bit, anything beyond the redzone is explicitly bounds-checked") \
     v(bool, crashIfWebAssemblyCantFastMemory, false, Normal, "If true, we will crash if we can't obtain fast memory for wasm.") \
-    v(unsigned, maxNumWebAssemblyFastMemories, 4, Normal, nullptr) \
+    v(unsigned, maxNumWebAssemblyFastMemories, 0, Normal, "The number of fast memory reservations, live or pooled for reuse, that we allow at once. 0 derives the limit from the available address space.") \
+    v(bool, shareWebAssemblyCodeAcrossMemoryModes, false, Normal, "If true, instances with a fast memory reuse a module's already compiled bounds checking code instead of compiling it again.") \
     v(bool, useFastTLSForWasmContext, true, Normal, "If true, we will store context in fast TLS. If false, we will pin it to a register.") \
     v(bool, useWebAssemblyStreamingApi, enableWebAssemblyStreamingApi, Normal, "Allow to run WebAssembly's Streaming API") \
+    v(bool, useWebAssemblyThreads, false, Normal, "Allow shared WebAssembly memories and the atomic instructions of the threads proposal.") \
     v(bool, useCallICsForWebAssemblyToJSCalls, true, Normal, "If true, we will use CallLinkInfo to inline cache Wasm to JS calls.") \
     v(bool, useEagerWebAssemblyModuleHashing, false, Normal, "Unnamed WebAssembly modules are identified in backtraces through their hash, if available.") \
+    v(bool, useWebAssemblyFunctionProfiling, false, Normal, "If true, WebAssembly code counts calls to each function, and records each function's compile time and code size for every tier.") \
+    v(bool, useWebAssemblyModuleCache, false, Normal, "If true, modules with identical bytes share one Wasm::Module, and so its compiled code, within the process. Nothing is persisted across processes.") \
+    v(unsigned, webAssemblyModuleCacheSize, 16, Normal, "The number of modules the Web Assembly module cache keeps alive.") \
     v(bool, useObjectRestSpread, true, Normal, "If true, we will enable Object Rest/Spread feature.") \
     v(bool, useBigInt, false, Normal, "If true, we will enable BigInt support.") \
     v(bool, useIntlNumberFormatToParts, enableIntlNumberFormatToParts, Normal, "If true, we will enable Intl.NumberFormat.prototype.formatToParts") \
@@ -83,6 +83,21 @@ static bool hasRestrictedGlobalProperty(ExecState* exec, JSGlobalObject* globalO
     return true;
 }
 
+JSObject* ProgramExecutable::prepare(VM& vm, JSGlobalObject* globalObject)
+{
+    ParserError error;
+    JSParserStrictMode strictMode = isStrictMode() ? JSParserStrictMode::Strict : JSParserStrictMode::NotStrict;
+    DebuggerMode debuggerMode = globalObject->hasInteractiveDebugger() ? DebuggerOn : DebuggerOff;
+
+    UnlinkedProgramCodeBlock* unlinkedCodeBlock = vm.codeCache()->getUnlinkedProgramCodeBlock(
+        vm, this, source(), strictMode, debuggerMode, error);
+    if (error.isValid())
+        return error.toErrorObject(globalObject, source());
+
+    m_unlinkedProgramCodeBlock.set(vm, this, unlinkedCodeBlock);
+    return nullptr;
+}
+
 JSObject* ProgramExecutable::initializeGlobalProperties(VM& vm, CallFrame* callFrame, JSScope* scope)
 {
     auto throwScope = DECLARE_THROW_SCOPE(vm);
@@ -95,8 +110,13 @@ JSObject* ProgramExecutable::initializeGlobalProperties(VM& vm, CallFrame* callF
     JSParserStrictMode strictMode = isStrictMode() ? JSParserStrictMode::Strict : JSParserStrictMode::NotStrict;
     DebuggerMode debuggerMode = globalObject->hasInteractiveDebugger() ? DebuggerOn : DebuggerOff;
 
-    UnlinkedProgramCodeBlock* unlinkedCodeBlock = vm.codeCache()->getUnlinkedProgramCodeBlock(
-        vm, this, source(), strictMode, debuggerMode, error);
+    // prepare() may have generated the code already, but without debugging opcodes if the debugger
+    // has been attached since.
+    UnlinkedProgramCodeBlock* unlinkedCodeBlock = m_unlinkedProgramCodeBlock.get();
+    if (!unlinkedCodeBlock || unlinkedCodeBlock->wasCompiledWithDebuggingOpcodes() != (debuggerMode == DebuggerOn)) {
+        unlinkedCodeBlock = vm.codeCache()->getUnlinkedProgramCodeBlock(
+            vm, this, source(), strictMode, debuggerMode, error);
+    }
 
     if (globalObject->hasDebugger())
         globalObject->debugger()->sourceParsed(callFrame, source().provider(), error.line(), error.message());
@@ -50,6 +50,9 @@ public:
         return executable;
     }
 
+    // Generates the unlinked code that initializeGlobalProperties() would otherwise get from the
+    // CodeCache, and keeps it with the executable. Returns a syntax error or null.
+    JSObject* prepare(VM&, JSGlobalObject*);
     JSObject* initializeGlobalProperties(VM&, CallFrame*, JSScope*);
 
     static void destroy(JSCell*);
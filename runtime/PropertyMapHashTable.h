@@ -131,6 +131,7 @@ public:
 
     static const bool needsDestruction = true;
     static void destroy(JSCell*);
+    static size_t estimatedSize(JSCell*, VM&);
 
     DECLARE_EXPORT_INFO;
 
@@ -219,6 +220,13 @@ private:
     // The capacity of the table of values is half of the size of the index.
     unsigned tableCapacity() const;
 
+    // Tables whose entry indices (including deletedEntryIndex()) fit in 16 bits use a
+    // uint16_t index instead of an unsigned one. Almost every Structure is small enough.
+    bool isCompact() const;
+    size_t indexEntrySize() const;
+    unsigned indexAt(unsigned) const;
+    void setIndexAt(unsigned, unsigned entryIndex);
+
     // We keep an extra deleted slot after the array to make iteration work,
     // and to use for deleted values. Index values into the array are 1-based,
     // so this is tableCapacity() + 1.
@@ -243,7 +251,7 @@ private:
     unsigned usedCount() const;
 
     // The size in bytes of data needed for by the table.
-    size_t dataSize();
+    size_t dataSize() const;
 
     // Calculates the appropriate table size (rounds up to a power of two).
     static unsigned sizeForCapacity(unsigned capacity);
@@ -253,12 +261,13 @@ private:
 
     unsigned m_indexSize;
     unsigned m_indexMask;
-    unsigned* m_index;
+    void* m_index;
     unsigned m_keyCount;
     unsigned m_deletedCount;
     std::unique_ptr<Vector<PropertyOffset>> m_deletedOffsets;
 
     static const unsigned MinimumTableSize = 16;
+    static const unsigned MaximumCompactIndexSize = 1 << 16;
 };
 
 inline PropertyTable::iterator PropertyTable::begin()
@@ -296,7 +305,7 @@ inline PropertyTable::find_iterator PropertyTable::find(const KeyType& key)
 #endif
 
     while (true) {
-        unsigned entryIndex = m_index[hash & m_indexMask];
+        unsigned entryIndex = indexAt(hash & m_indexMask);
         if (entryIndex == EmptyEntryIndex)
             return std::make_pair((ValueType*)0, hash & m_indexMask);
         if (key == table()[entryIndex - 1].key)
@@ -330,7 +339,7 @@ inline PropertyTable::ValueType* PropertyTable::get(const KeyType& key)
 #endif
 
     while (true) {
-        unsigned entryIndex = m_index[hash & m_indexMask];
+        unsigned entryIndex = indexAt(hash & m_indexMask);
         if (entryIndex == EmptyEntryIndex)
             return nullptr;
         if (key == table()[entryIndex - 1].key)
@@ -369,7 +378,7 @@ inline std::pair<PropertyTable::find_iterator, bool> PropertyTable::add(const Va
 
     // Allocate a slot in the hashtable, and set the index to reference this.
     unsigned entryIndex = usedCount() + 1;
-    m_index[iter.second] = entryIndex;
+    setIndexAt(iter.second, entryIndex);
     iter.first = &table()[entryIndex - 1];
     *iter.first = entry;
 
@@ -395,7 +404,7 @@ inline void PropertyTable::remove(const find_iterator& iter)
 
     // Replace this one element with the deleted sentinel. Also clear out
     // the entry so we can iterate all the entries as needed.
-    m_index[iter.second] = deletedEntryIndex();
+    setIndexAt(iter.second, deletedEntryIndex());
     iter.first->key->deref();
     iter.first->key = PROPERTY_MAP_DELETED_ENTRY_KEY;
 
@@ -494,7 +503,7 @@ inline void PropertyTable::reinsert(const ValueType& entry)
     ASSERT(!iter.first);
 
     unsigned entryIndex = usedCount() + 1;
-    m_index[iter.second] = entryIndex;
+    setIndexAt(iter.second, entryIndex);
     table()[entryIndex - 1] = entry;
 
     ++m_keyCount;
@@ -506,7 +515,7 @@ inline void PropertyTable::rehash(unsigned newCapacity)
     ++propertyMapHashTableStats->numRehashes;
 #endif
 
-    unsigned* oldEntryIndices = m_index;
+    void* oldEntryIndices = m_index;
     iterator iter = this->begin();
     iterator end = this->end();
 
@@ -514,7 +523,7 @@ inline void PropertyTable::rehash(unsigned newCapacity)
     m_indexMask = m_indexSize - 1;
     m_keyCount = 0;
     m_deletedCount = 0;
-    m_index = static_cast<unsigned*>(fastZeroedMalloc(dataSize()));
+    m_index = fastZeroedMalloc(dataSize());
 
     for (; iter != end; ++iter) {
         ASSERT(canInsert());
@@ -528,6 +537,35 @@ inline unsigned PropertyTable::tableCapacity() const { return m_indexSize >> 1;
 
 inline unsigned PropertyTable::deletedEntryIndex() const { return tableCapacity() + 1; }
 
+inline bool PropertyTable::isCompact() const
+{
+    static_assert(MaximumCompactIndexSize / 2 + 1 <= std::numeric_limits<uint16_t>::max(), "deletedEntryIndex() must fit in a compact index");
+    return m_indexSize <= MaximumCompactIndexSize;
+}
+
+inline size_t PropertyTable::indexEntrySize() const
+{
+    return isCompact() ? sizeof(uint16_t) : sizeof(unsigned);
+}
+
+inline unsigned PropertyTable::indexAt(unsigned i) const
+{
+    ASSERT(i < m_indexSize);
+    if (isCompact())
+        return static_cast<const uint16_t*>(m_index)[i];
+    return static_cast<const unsigned*>(m_index)[i];
+}
+
+inline void PropertyTable::setIndexAt(unsigned i, unsigned entryIndex)
+{
+    ASSERT(i < m_indexSize);
+    ASSERT(entryIndex <= deletedEntryIndex());
+    if (isCompact())
+        static_cast<uint16_t*>(m_index)[i] = entryIndex;
+    else
+        static_cast<unsigned*>(m_index)[i] = entryIndex;
+}
+
 template<typename T>
 inline T* PropertyTable::skipDeletedEntries(T* valuePtr, T* endValuePtr)
 {
@@ -539,13 +577,13 @@ inline T* PropertyTable::skipDeletedEntries(T* valuePtr, T* endValuePtr)
 inline PropertyTable::ValueType* PropertyTable::table()
 {
     // The table of values lies after the hash index.
-    return reinterpret_cast<ValueType*>(m_index + m_indexSize);
+    return reinterpret_cast<ValueType*>(static_cast<char*>(m_index) + m_indexSize * indexEntrySize());
 }
 
 inline const PropertyTable::ValueType* PropertyTable::table() const
 {
     // The table of values lies after the hash index.
-    return reinterpret_cast<const ValueType*>(m_index + m_indexSize);
+    return reinterpret_cast<const ValueType*>(static_cast<const char*>(m_index) + m_indexSize * indexEntrySize());
 }
 
 inline unsigned PropertyTable::usedCount() const
@@ -554,10 +592,10 @@ inline unsigned PropertyTable::usedCount() const
     return m_keyCount + m_deletedCount;
 }
 
-inline size_t PropertyTable::dataSize()
+inline size_t PropertyTable::dataSize() const
 {
     // The size in bytes of data needed for by the table.
-    return m_indexSize * sizeof(unsigned) + ((tableCapacity()) + 1) * sizeof(ValueType);
+    return m_indexSize * indexEntrySize() + ((tableCapacity()) + 1) * sizeof(ValueType);
 }
 
 inline unsigned PropertyTable::sizeForCapacity(unsigned capacity)
@@ -57,7 +57,7 @@ PropertyTable::PropertyTable(VM& vm, unsigned initialCapacity)
     : JSCell(vm, vm.propertyTableStructure.get())
     , m_indexSize(sizeForCapacity(initialCapacity))
     , m_indexMask(m_indexSize - 1)
-    , m_index(static_cast<unsigned*>(fastZeroedMalloc(dataSize())))
+    , m_index(fastZeroedMalloc(dataSize()))
     , m_keyCount(0)
     , m_deletedCount(0)
 {
@@ -68,7 +68,7 @@ PropertyTable::PropertyTable(VM& vm, const PropertyTable& other)
     : JSCell(vm, vm.propertyTableStructure.get())
     , m_indexSize(other.m_indexSize)
     , m_indexMask(other.m_indexMask)
-    , m_index(static_cast<unsigned*>(fastMalloc(dataSize())))
+    , m_index(fastMalloc(dataSize()))
     , m_keyCount(other.m_keyCount)
     , m_deletedCount(other.m_deletedCount)
 {
@@ -90,7 +90,7 @@ PropertyTable::PropertyTable(VM& vm, unsigned initialCapacity, const PropertyTab
     : JSCell(vm, vm.propertyTableStructure.get())
     , m_indexSize(sizeForCapacity(initialCapacity))
     , m_indexMask(m_indexSize - 1)
-    , m_index(static_cast<unsigned*>(fastZeroedMalloc(dataSize())))
+    , m_index(fastZeroedMalloc(dataSize()))
     , m_keyCount(0)
     , m_deletedCount(0)
 {
@@ -115,6 +115,15 @@ void PropertyTable::destroy(JSCell* cell)
     static_cast<PropertyTable*>(cell)->PropertyTable::~PropertyTable();
 }
 
+size_t PropertyTable::estimatedSize(JSCell* cell, VM& vm)
+{
+    PropertyTable* thisObject = jsCast<PropertyTable*>(cell);
+    size_t result = Base::estimatedSize(cell, vm) + thisObject->dataSize();
+    if (thisObject->m_deletedOffsets)
+        result += thisObject->m_deletedOffsets->capacity() * sizeof(PropertyOffset);
+    return result;
+}
+
 PropertyTable::~PropertyTable()
 {
     iterator end = this->end();
@@ -0,0 +1,478 @@
+/*
+ * Copyright (C) 2026 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <limits>
+#include <wtf/ASCIICType.h>
+#include <wtf/text/StringImpl.h>
+#include <wtf/text/StringView.h>
+#include <wtf/text/WTFString.h>
+
+#if CPU(X86_64) && COMPILER(GCC_OR_CLANG)
+#define JSC_STRING_KERNELS_SSE2 1
+#include <emmintrin.h>
+#elif CPU(ARM64) && COMPILER(GCC_OR_CLANG)
+#define JSC_STRING_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Vectorized kernels for the hot String.prototype operations. Every kernel works on both
+// Latin-1 and UTF-16 buffers: it walks the string 16 bytes at a time, turns a lane-wise
+// comparison into a bit mask and falls back to a scalar loop for the tail. Platforms
+// without SSE2 or NEON only get the scalar loops.
+
+namespace JSC {
+namespace StringKernels {
+
+#if defined(JSC_STRING_KERNELS_SSE2) || defined(JSC_STRING_KERNELS_NEON)
+
+#if defined(JSC_STRING_KERNELS_SSE2)
+// _mm_movemask_epi8 produces one bit per byte.
+using ChunkMask = uint32_t;
+static constexpr unsigned maskBitsPerByte = 1;
+static constexpr ChunkMask allMaskBits = 0xffff;
+
+template<typename CharacterType> struct Chunk;
+
+template<> struct Chunk<LChar> {
+    using Vector = __m128i;
+    static ALWAYS_INLINE Vector load(const LChar* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static ALWAYS_INLINE void store(LChar* p, Vector v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static ALWAYS_INLINE Vector splat(LChar c) { return _mm_set1_epi8(static_cast<char>(c)); }
+    static ALWAYS_INLINE Vector equal(Vector a, Vector b) { return _mm_cmpeq_epi8(a, b); }
+    static ALWAYS_INLINE Vector greaterThan(Vector a, Vector b)
+    {
+        // SSE2 only has signed comparisons, so bias both sides into the signed range.
+        Vector bias = _mm_set1_epi8(static_cast<char>(0x80));
+        return _mm_cmpgt_epi8(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+    }
+    static ALWAYS_INLINE Vector sub(Vector a, Vector b) { return _mm_sub_epi8(a, b); }
+    static ALWAYS_INLINE Vector bitOr(Vector a, Vector b) { return _mm_or_si128(a, b); }
+    static ALWAYS_INLINE Vector bitAnd(Vector a, Vector b) { return _mm_and_si128(a, b); }
+    static ALWAYS_INLINE Vector bitXor(Vector a, Vector b) { return _mm_xor_si128(a, b); }
+    static ALWAYS_INLINE ChunkMask mask(Vector v) { return static_cast<ChunkMask>(_mm_movemask_epi8(v)); }
+};
+
+template<> struct Chunk<UChar> {
+    using Vector = __m128i;
+    static ALWAYS_INLINE Vector load(const UChar* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static ALWAYS_INLINE void store(UChar* p, Vector v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static ALWAYS_INLINE Vector splat(UChar c) { return _mm_set1_epi16(static_cast<short>(c)); }
+    static ALWAYS_INLINE Vector equal(Vector a, Vector b) { return _mm_cmpeq_epi16(a, b); }
+    static ALWAYS_INLINE Vector greaterThan(Vector a, Vector b)
+    {
+        Vector bias = _mm_set1_epi16(static_cast<short>(0x8000));
+        return _mm_cmpgt_epi16(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+    }
+    static ALWAYS_INLINE Vector sub(Vector a, Vector b) { return _mm_sub_epi16(a, b); }
+    static ALWAYS_INLINE Vector bitOr(Vector a, Vector b) { return _mm_or_si128(a, b); }
+    static ALWAYS_INLINE Vector bitAnd(Vector a, Vector b) { return _mm_and_si128(a, b); }
+    static ALWAYS_INLINE Vector bitXor(Vector a, Vector b) { return _mm_xor_si128(a, b); }
+    static ALWAYS_INLINE ChunkMask mask(Vector v) { return static_cast<ChunkMask>(_mm_movemask_epi8(v)); }
+};
+
+ALWAYS_INLINE unsigned firstSetBit(ChunkMask mask) { return __builtin_ctz(mask); }
+ALWAYS_INLINE unsigned lastSetBit(ChunkMask mask) { return 31 - __builtin_clz(mask); }
+#else
+// NEON has no movemask. Narrowing each 16-bit lane by 4 bits packs the byte-wise comparison
+// result into a 64-bit value with four bits per byte.
+using ChunkMask = uint64_t;
+static constexpr unsigned maskBitsPerByte = 4;
+static constexpr ChunkMask allMaskBits = std::numeric_limits<uint64_t>::max();
+
+ALWAYS_INLINE ChunkMask maskFromBytes(uint8x16_t v)
+{
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(v), 4)), 0);
+}
+
+template<typename CharacterType> struct Chunk;
+
+template<> struct Chunk<LChar> {
+    using Vector = uint8x16_t;
+    static ALWAYS_INLINE Vector load(const LChar* p) { return vld1q_u8(p); }
+    static ALWAYS_INLINE void store(LChar* p, Vector v) { vst1q_u8(p, v); }
+    static ALWAYS_INLINE Vector splat(LChar c) { return vdupq_n_u8(c); }
+    static ALWAYS_INLINE Vector equal(Vector a, Vector b) { return vceqq_u8(a, b); }
+    static ALWAYS_INLINE Vector greaterThan(Vector a, Vector b) { return vcgtq_u8(a, b); }
+    static ALWAYS_INLINE Vector sub(Vector a, Vector b) { return vsubq_u8(a, b); }
+    static ALWAYS_INLINE Vector bitOr(Vector a, Vector b) { return vorrq_u8(a, b); }
+    static ALWAYS_INLINE Vector bitAnd(Vector a, Vector b) { return vandq_u8(a, b); }
+    static ALWAYS_INLINE Vector bitXor(Vector a, Vector b) { return veorq_u8(a, b); }
+    static ALWAYS_INLINE ChunkMask mask(Vector v) { return maskFromBytes(v); }
+};
+
+template<> struct Chunk<UChar> {
+    using Vector = uint16x8_t;
+    static ALWAYS_INLINE Vector load(const UChar* p) { return vld1q_u16(reinterpret_cast<const uint16_t*>(p)); }
+    static ALWAYS_INLINE void store(UChar* p, Vector v) { vst1q_u16(reinterpret_cast<uint16_t*>(p), v); }
+    static ALWAYS_INLINE Vector splat(UChar c) { return vdupq_n_u16(c); }
+    static ALWAYS_INLINE Vector equal(Vector a, Vector b) { return vceqq_u16(a, b); }
+    static ALWAYS_INLINE Vector greaterThan(Vector a, Vector b) { return vcgtq_u16(a, b); }
+    static ALWAYS_INLINE Vector sub(Vector a, Vector b) { return vsubq_u16(a, b); }
+    static ALWAYS_INLINE Vector bitOr(Vector a, Vector b) { return vorrq_u16(a, b); }
+    static ALWAYS_INLINE Vector bitAnd(Vector a, Vector b) { return vandq_u16(a, b); }
+    static ALWAYS_INLINE Vector bitXor(Vector a, Vector b) { return veorq_u16(a, b); }
+    static ALWAYS_INLINE ChunkMask mask(Vector v) { return maskFromBytes(vreinterpretq_u8_u16(v)); }
+};
+
+ALWAYS_INLINE unsigned firstSetBit(ChunkMask mask) { return __builtin_ctzll(mask); }
+ALWAYS_INLINE unsigned lastSetBit(ChunkMask mask) { return 63 - __builtin_clzll(mask); }
+#endif
+
+static constexpr unsigned chunkBytes = 16;
+
+template<typename CharacterType>
+constexpr unsigned charactersPerChunk() { return chunkBytes / sizeof(CharacterType); }
+
+template<typename CharacterType>
+ALWAYS_INLINE unsigned firstLane(ChunkMask mask)
+{
+    return firstSetBit(mask) / (maskBitsPerByte * sizeof(CharacterType));
+}
+
+template<typename CharacterType>
+ALWAYS_INLINE unsigned lastLane(ChunkMask mask)
+{
+    return lastSetBit(mask) / (maskBitsPerByte * sizeof(CharacterType));
+}
+
+#define JSC_STRING_KERNELS_VECTORIZED 1
+#endif // defined(JSC_STRING_KERNELS_SSE2) || defined(JSC_STRING_KERNELS_NEON)
+
+template<typename CharacterType>
+inline size_t findCharacter(const CharacterType* characters, unsigned length, CharacterType match, unsigned start)
+{
+    unsigned i = start;
+#if defined(JSC_STRING_KERNELS_VECTORIZED)
+    using C = Chunk<CharacterType>;
+    constexpr unsigned lanes = charactersPerChunk<CharacterType>();
+    if (length >= lanes) {
+        auto needle = C::splat(match);
+        for (; i <= length - lanes; i += lanes) {
+            if (ChunkMask mask = C::mask(C::equal(C::load(characters + i), needle)))
+                return i + firstLane<CharacterType>(mask);
+        }
+    }
+#endif
+    for (; i < length; ++i) {
+        if (characters[i] == match)
+            return i;
+    }
+    return notFound;
+}
+
+inline size_t findCharacter(const LChar* characters, unsigned length, UChar match, unsigned start)
+{
+    if (match & ~0xff)
+        return notFound;
+    return findCharacter(characters, length, static_cast<LChar>(match), start);
+}
+
+inline size_t findCharacter(const UChar* characters, unsigned length, LChar match, unsigned start)
+{
+    return findCharacter(characters, length, static_cast<UChar>(match), start);
+}
+
+// Finds the first character of the pattern with findCharacter(), then rejects candidates by
+// their last character before comparing the whole pattern.
+template<typename SearchCharacterType, typename MatchCharacterType>
+inline size_t findSubstring(const SearchCharacterType* characters, unsigned length, const MatchCharacterType* match, unsigned matchLength, unsigned start)
+{
+    ASSERT(matchLength);
+    if (matchLength > length || start > length - matchLength)
+        return notFound;
+
+    // Candidate starting positions are [start, length - matchLength].
+    unsigned candidateEnd = length - matchLength + 1;
+    MatchCharacterType firstCharacter = match[0];
+    MatchCharacterType lastCharacter = match[matchLength - 1];
+    unsigned i = start;
+    while (true) {
+        size_t candidate = findCharacter(characters, candidateEnd, firstCharacter, i);
+        if (candidate == notFound)
+            return notFound;
+        if (characters[candidate + matchLength - 1] == lastCharacter
+            && WTF::equal(characters + candidate + 1, match + 1, matchLength - 1))
+            return candidate;
+        i = candidate + 1;
+    }
+}
+
+inline size_t findSubstring(StringView string, StringView match, unsigned start)
+{
+    if (match.isEmpty())
+        return std::min(start, string.length());
+    if (string.is8Bit()) {
+        if (match.is8Bit())
+            return findSubstring(string.characters8(), string.length(), match.characters8(), match.length(), start);
+        return findSubstring(string.characters8(), string.length(), match.characters16(), match.length(), start);
+    }
+    if (match.is8Bit())
+        return findSubstring(string.characters16(), string.length(), match.characters8(), match.length(), start);
+    return findSubstring(string.characters16(), string.length(), match.characters16(), match.length(), start);
+}
+
+template<typename CharacterType>
+inline size_t findFirstNonASCII(const CharacterType* characters, unsigned length, unsigned start)
+{
+    unsigned i = start;
+#if defined(JSC_STRING_KERNELS_VECTORIZED)
+    using C = Chunk<CharacterType>;
+    constexpr unsigned lanes = charactersPerChunk<CharacterType>();
+    if (length >= lanes) {
+        auto maxASCII = C::splat(0x7f);
+        for (; i <= length - lanes; i += lanes) {
+            if (ChunkMask mask = C::mask(C::greaterThan(C::load(characters + i), maxASCII)))
+                return i + firstLane<CharacterType>(mask);
+        }
+    }
+#endif
+    for (; i < length; ++i) {
+        if (!isASCII(characters[i]))
+            return i;
+    }
+    return length;
+}
+
+enum class ASCIICaseConversion { ToLower, ToUpper };
+
+template<ASCIICaseConversion conversion>
+constexpr UChar firstCharacterToConvert() { return conversion == ASCIICaseConversion::ToLower ? 'A' : 'a'; }
+
+template<ASCIICaseConversion conversion, typename CharacterType>
+ALWAYS_INLINE bool needsConversion(CharacterType character)
+{
+    return static_cast<unsigned>(character - firstCharacterToConvert<conversion>()) < 26;
+}
+
+// Returns the index of the first character that the ASCII conversion would change or that is
+// not ASCII at all, or the length if there is none.
+template<ASCIICaseConversion conversion, typename CharacterType>
+inline size_t findFirstCharacterToConvert(const CharacterType* characters, unsigned length, unsigned start)
+{
+    unsigned i = start;
+#if defined(JSC_STRING_KERNELS_VECTORIZED)
+    using C = Chunk<CharacterType>;
+    constexpr unsigned lanes = charactersPerChunk<CharacterType>();
+    if (length >= lanes) {
+        auto first = C::splat(firstCharacterToConvert<conversion>());
+        auto alphabetSize = C::splat(26);
+        auto maxASCII = C::splat(0x7f);
+        for (; i <= length - lanes; i += lanes) {
+            auto chunk = C::load(characters + i);
+            auto isLetter = C::greaterThan(alphabetSize, C::sub(chunk, first));
+            if (ChunkMask mask = C::mask(C::bitOr(isLetter, C::greaterThan(chunk, maxASCII))))
+                return i + firstLane<CharacterType>(mask);
+        }
+    }
+#endif
+    for (; i < length; ++i) {
+        CharacterType character = characters[i];
+        if (!isASCII(character) || needsConversion<conversion>(character))
+            return i;
+    }
+    return length;
+}
+
+// Requires every character in the source to be ASCII.
+template<ASCIICaseConversion conversion, typename CharacterType>
+inline void convertASCIICase(const CharacterType* source, CharacterType* destination, unsigned length)
+{
+    unsigned i = 0;
+#if defined(JSC_STRING_KERNELS_VECTORIZED)
+    using C = Chunk<CharacterType>;
+    constexpr unsigned lanes = charactersPerChunk<CharacterType>();
+    if (length >= lanes) {
+        auto first = C::splat(firstCharacterToConvert<conversion>());
+        auto alphabetSize = C::splat(26);
+        auto caseBit = C::splat(0x20);
+        for (; i <= length - lanes; i += lanes) {
+            auto chunk = C::load(source + i);
+            auto isLetter = C::greaterThan(alphabetSize, C::sub(chunk, first));
+            C::store(destination + i, C::bitXor(chunk, C::bitAnd(isLetter, caseBit)));
+        }
+    }
+#endif
+    for (; i < length; ++i) {
+        CharacterType character = source[i];
+        ASSERT(isASCII(character));
+        destination[i] = needsConversion<conversion>(character) ? character ^ 0x20 : character;
+    }
+}
+
+template<ASCIICaseConversion conversion, typename CharacterType>
+inline String convertASCIICase(const String& string, const CharacterType* characters, unsigned failingIndex)
+{
+    unsigned length = string.length();
+    size_t index = findFirstCharacterToConvert<conversion>(characters, length, failingIndex);
+    if (index == length)
+        return string;
+    if (findFirstNonASCII(characters, length, index) != length)
+        return String();
+
+    CharacterType* buffer;
+    auto result = StringImpl::createUninitialized(length, buffer);
+    memcpy(buffer, characters, index * sizeof(CharacterType));
+    convertASCIICase<conversion>(characters + index, buffer + index, length - index);
+    return String(WTFMove(result));
+}
+
+// Case conversion without locale. All-ASCII strings are converted by the vector kernels;
+// anything else is handed to WTF's full Unicode mapping. Every character before failingIndex
+// must already be known to be ASCII and unaffected by the conversion.
+template<ASCIICaseConversion conversion>
+inline String convertCaseWithoutLocale(const String& string, unsigned failingIndex = 0)
+{
+    String result = string.is8Bit()
+        ? convertASCIICase<conversion>(string, string.characters8(), failingIndex)
+        : convertASCIICase<conversion>(string, string.characters16(), failingIndex);
+    if (!result.isNull())
+        return result;
+    if (conversion == ASCIICaseConversion::ToUpper)
+        return string.convertToUppercaseWithoutLocale();
+    if (string.is8Bit())
+        return string.convertToLowercaseWithoutLocaleStartingAtFailingIndex8Bit(failingIndex);
+    return string.convertToLowercaseWithoutLocale();
+}
+
+#if defined(JSC_STRING_KERNELS_VECTORIZED)
+// Lanes holding one of the Latin-1 StrWhiteSpaceChars: U+0009-U+000D, U+0020 and U+00A0.
+template<typename CharacterType>
+ALWAYS_INLINE typename Chunk<CharacterType>::Vector latin1WhiteSpaceLanes(typename Chunk<CharacterType>::Vector chunk)
+{
+    using C = Chunk<CharacterType>;
+    auto isControl = C::greaterThan(C::splat(5), C::sub(chunk, C::splat(0x09)));
+    auto isSpace = C::bitOr(C::equal(chunk, C::splat(0x20)), C::equal(chunk, C::splat(0xa0)));
+    return C::bitOr(isControl, isSpace);
+}
+#endif
+
+// Skips Latin-1 white space forward from start and returns the index of the first other
+// character (which may still be non-Latin-1 white space), or end.
+template<typename CharacterType>
+inline unsigned skipLatin1WhiteSpaceForward(const CharacterType* characters, unsigned start, unsigned end)
+{
+    unsigned i = start;
+#if defined(JSC_STRING_KERNELS_VECTORIZED)
+    using C = Chunk<CharacterType>;
+    constexpr unsigned lanes = charactersPerChunk<CharacterType>();
+    for (; end - i >= lanes; i += lanes) {
+        ChunkMask other = ~C::mask(latin1WhiteSpaceLanes<CharacterType>(C::load(characters + i))) & allMaskBits;
+        if (other)
+            return i + firstLane<CharacterType>(other);
+    }
+#endif
+    for (; i < end; ++i) {
+        CharacterType character = characters[i];
+        if (character != 0x20 && character != 0xa0 && static_cast<unsigned>(character - 0x09) >= 5)
+            return i;
+    }
+    return end;
+}
+
+// Skips Latin-1 white space backward from end and returns one past the index of the last other
+// character, or start.
+template<typename CharacterType>
+inline unsigned skipLatin1WhiteSpaceBackward(const CharacterType* characters, unsigned start, unsigned end)
+{
+    unsigned i = end;
+#if defined(JSC_STRING_KERNELS_VECTORIZED)
+    using C = Chunk<CharacterType>;
+    constexpr unsigned lanes = charactersPerChunk<CharacterType>();
+    for (; i - start >= lanes; i -= lanes) {
+        ChunkMask other = ~C::mask(latin1WhiteSpaceLanes<CharacterType>(C::load(characters + i - lanes))) & allMaskBits;
+        if (other)
+            return i - lanes + lastLane<CharacterType>(other) + 1;
+    }
+#endif
+    for (; i > start; --i) {
+        CharacterType character = characters[i - 1];
+        if (character != 0x20 && character != 0xa0 && static_cast<unsigned>(character - 0x09) >= 5)
+            return i;
+    }
+    return start;
+}
+
+// Returns how many characters at the start of the buffer can be taken into a strict JSON string
+// token verbatim, that is, everything before the first control character, backslash or
+// terminator.
+template<typename CharacterType>
+inline unsigned countPlainJSONStringCharacters(const CharacterType* characters, unsigned length, CharacterType terminator)
+{
+    unsigned i = 0;
+#if defined(JSC_STRING_KERNELS_VECTORIZED)
+    using C = Chunk<CharacterType>;
+    constexpr unsigned lanes = charactersPerChunk<CharacterType>();
+    if (length >= lanes) {
+        auto space = C::splat(' ');
+        auto backslash = C::splat('\\');
+        auto quote = C::splat(terminator);
+        for (; i <= length - lanes; i += lanes) {
+            auto chunk = C::load(characters + i);
+            auto special = C::bitOr(C::greaterThan(space, chunk), C::bitOr(C::equal(chunk, backslash), C::equal(chunk, quote)));
+            if (ChunkMask mask = C::mask(special))
+                return i + firstLane<CharacterType>(mask);
+        }
+    }
+#endif
+    for (; i < length; ++i) {
+        CharacterType character = characters[i];
+        if (character < ' ' || character == '\\' || character == terminator)
+            return i;
+    }
+    return length;
+}
+
+// Returns how many characters at the start of the buffer are JSON white space (RFC 4627).
+template<typename CharacterType>
+inline unsigned countJSONWhiteSpace(const CharacterType* characters, unsigned length)
+{
+    unsigned i = 0;
+#if defined(JSC_STRING_KERNELS_VECTORIZED)
+    using C = Chunk<CharacterType>;
+    constexpr unsigned lanes = charactersPerChunk<CharacterType>();
+    if (length >= lanes) {
+        auto space = C::splat(' ');
+        auto tab = C::splat('\t');
+        auto lineFeed = C::splat('\n');
+        auto carriageReturn = C::splat('\r');
+        for (; i <= length - lanes; i += lanes) {
+            auto chunk = C::load(characters + i);
+            auto whiteSpace = C::bitOr(C::bitOr(C::equal(chunk, space), C::equal(chunk, tab)), C::bitOr(C::equal(chunk, lineFeed), C::equal(chunk, carriageReturn)));
+            if (ChunkMask other = ~C::mask(whiteSpace) & allMaskBits)
+                return i + firstLane<CharacterType>(other);
+        }
+    }
+#endif
+    for (; i < length; ++i) {
+        CharacterType character = characters[i];
+        if (character != ' ' && character != '\t' && character != '\n' && character != '\r')
+            return i;
+    }
+    return length;
+}
+
+} } // namespace JSC::StringKernels
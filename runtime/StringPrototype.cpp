@@ -44,6 +44,7 @@
 #include "RegExpCache.h"
 #include "RegExpConstructor.h"
 #include "RegExpObject.h"
+#include "StringKernels.h"
 #include "SuperSampler.h"
 #include <algorithm>
 #include <unicode/uconfig.h>
@@ -1099,7 +1100,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncIndexOf(ExecState* exec)
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
     auto otherViewWithString = otherJSString->viewWithUnderlyingString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
-    size_t result = thisViewWithString.view.find(otherViewWithString.view, pos);
+    size_t result = StringKernels::findSubstring(thisViewWithString.view, otherViewWithString.view, pos);
     if (result == notFound)
         return JSValue::encode(jsNumber(-1));
     return JSValue::encode(jsNumber(result));
@@ -1197,7 +1198,7 @@ static ALWAYS_INLINE bool splitStringByOneCharacterImpl(ExecState* exec, JSArray
     //   a. Call SplitMatch(S, q, R) and let z be its MatchResult result.
     //   b. If z is failure, then let q = q+1.
     //   c. Else, z is not failure
-    while ((matchPosition = WTF::find(characters, string->length(), separatorCharacter, position)) != notFound) {
+    while ((matchPosition = StringKernels::findCharacter(characters, string->length(), separatorCharacter, position)) != notFound) {
         // 1. Let T be a String value equal to the substring of S consisting of the characters at positions p (inclusive)
         //    through q (exclusive).
         // 2. Call the [[DefineOwnProperty]] internal method of A with arguments ToString(lengthA),
@@ -1465,7 +1466,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncToLowerCase(ExecState* exec)
     JSString* sVal = thisValue.toString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
     const String& s = sVal->value(exec);
-    String lowercasedString = s.convertToLowercaseWithoutLocale();
+    String lowercasedString = StringKernels::convertCaseWithoutLocale<StringKernels::ASCIICaseConversion::ToLower>(s);
     if (lowercasedString.impl() == s.impl())
         return JSValue::encode(sVal);
     scope.release();
@@ -1483,7 +1484,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncToUpperCase(ExecState* exec)
     JSString* sVal = thisValue.toString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
     const String& s = sVal->value(exec);
-    String uppercasedString = s.convertToUppercaseWithoutLocale();
+    String uppercasedString = StringKernels::convertCaseWithoutLocale<StringKernels::ASCIICaseConversion::ToUpper>(s);
     if (uppercasedString.impl() == s.impl())
         return JSValue::encode(sVal);
     scope.release();
@@ -1614,6 +1615,23 @@ enum {
     TrimEnd = 2
 };
 
+template<typename CharacterType>
+static ALWAYS_INLINE void trimStringRange(const CharacterType* characters, unsigned& left, unsigned& right, int trimKind)
+{
+    // The vector kernels only recognize Latin-1 white space, so finish with isStrWhiteSpace()
+    // to pick up the remaining Zs characters.
+    if (trimKind & TrimStart) {
+        left = StringKernels::skipLatin1WhiteSpaceForward(characters, left, right);
+        while (left < right && isStrWhiteSpace(characters[left]))
+            left = StringKernels::skipLatin1WhiteSpaceForward(characters, left + 1, right);
+    }
+    if (trimKind & TrimEnd) {
+        right = StringKernels::skipLatin1WhiteSpaceBackward(characters, left, right);
+        while (right > left && isStrWhiteSpace(characters[right - 1]))
+            right = StringKernels::skipLatin1WhiteSpaceBackward(characters, left, right - 1);
+    }
+}
+
 static inline JSValue trimString(ExecState* exec, JSValue thisValue, int trimKind)
 {
     VM& vm = exec->vm();
@@ -1625,15 +1643,11 @@ static inline JSValue trimString(ExecState* exec, JSValue thisValue, int trimKin
     RETURN_IF_EXCEPTION(scope, { });
 
     unsigned left = 0;
-    if (trimKind & TrimStart) {
-        while (left < str.length() && isStrWhiteSpace(str[left]))
-            left++;
-    }
     unsigned right = str.length();
-    if (trimKind & TrimEnd) {
-        while (right > left && isStrWhiteSpace(str[right - 1]))
-            right--;
-    }
+    if (str.is8Bit())
+        trimStringRange(str.characters8(), left, right, trimKind);
+    else
+        trimStringRange(str.characters16(), left, right, trimKind);
 
     // Don't gc allocate a new string if we don't have to.
     if (left == 0 && right == str.length() && thisValue.isString())
@@ -1751,7 +1765,7 @@ static EncodedJSValue JSC_HOST_CALL stringIncludesImpl(VM& vm, ExecState* exec,
         RETURN_IF_EXCEPTION(scope, encodedJSValue());
     }
 
-    return JSValue::encode(jsBoolean(stringToSearchIn.find(searchString, start) != notFound));
+    return JSValue::encode(jsBoolean(StringKernels::findSubstring(stringToSearchIn, searchString, start) != notFound));
 }
 
 EncodedJSValue JSC_HOST_CALL stringProtoFuncIncludes(ExecState* exec)
@@ -1250,6 +1250,60 @@ JSPropertyNameEnumerator* Structure::cachedPropertyNameEnumerator() const
     return rareData()->cachedPropertyNameEnumerator();
 }
 
+void Structure::setCachedJSONPropertyList(VM& vm, Ref<CachedJSONPropertyList>&& propertyList)
+{
+    ASSERT(!isDictionary());
+    if (!hasRareData())
+        allocateRareData(vm);
+    rareData()->setCachedJSONPropertyList(WTFMove(propertyList));
+}
+
+CachedJSONPropertyList* Structure::cachedJSONPropertyList() const
+{
+    if (!hasRareData())
+        return nullptr;
+    return rareData()->cachedJSONPropertyList();
+}
+
+// Returns true if this Structure was reached from {ancestor} only by adding properties with no
+// attributes. An object with {ancestor} that gets the same properties in the same order ends up
+// with this Structure, and every storage slot up to totalStorageSize() holds a property.
+bool Structure::isPlainPropertyAdditionDescendantOf(const Structure* ancestor) const
+{
+    for (const Structure* structure = this; structure; structure = structure->previousID()) {
+        if (structure == ancestor)
+            return true;
+        if (structure->isDictionary() || !structure->m_nameInPrevious || structure->attributesInPrevious())
+            return false;
+    }
+    return false;
+}
+
+void Structure::setCachedOwnKeys(VM& vm, DontEnumPropertiesMode mode, JSImmutableButterfly* ownKeys)
+{
+    ASSERT(canCacheOwnKeys());
+    if (!hasRareData())
+        allocateRareData(vm);
+    rareData()->setCachedOwnKeys(vm, mode, ownKeys);
+}
+
+JSImmutableButterfly* Structure::cachedOwnKeys(DontEnumPropertiesMode mode) const
+{
+    if (!hasRareData())
+        return nullptr;
+    return rareData()->cachedOwnKeys(mode);
+}
+
+// A non-dictionary final object's own string keys are fixed by its Structure, so they can be
+// cached on it. Unlike the enumerator cache, the prototype chain does not matter.
+bool Structure::canCacheOwnKeys() const
+{
+    return typeInfo().type() == FinalObjectType
+        && !isDictionary()
+        && !hasIndexedProperties(indexingType())
+        && !typeInfo().overridesGetPropertyNames();
+}
+
 bool Structure::canCachePropertyNameEnumerator() const
 {
     auto canCache = [] (const Structure* structure) {
@@ -53,6 +53,7 @@ class UniquedStringImpl;
 
 namespace JSC {
 
+class CachedJSONPropertyList;
 class DeferGC;
 class LLIntOffsetsExtractor;
 class PropertyNameArray;
@@ -475,6 +476,15 @@ public:
     bool canCachePropertyNameEnumerator() const;
     bool canAccessPropertiesQuicklyForEnumeration() const;
 
+    void setCachedJSONPropertyList(VM&, Ref<CachedJSONPropertyList>&&);
+    CachedJSONPropertyList* cachedJSONPropertyList() const;
+
+    bool isPlainPropertyAdditionDescendantOf(const Structure*) const;
+
+    void setCachedOwnKeys(VM&, DontEnumPropertiesMode, JSImmutableButterfly*);
+    JSImmutableButterfly* cachedOwnKeys(DontEnumPropertiesMode) const;
+    bool canCacheOwnKeys() const;
+
     void getPropertyNamesFromStructure(VM&, PropertyNameArray&, EnumerationMode);
 
     JSString* objectToStringValue()
@@ -26,81 +26,104 @@
 #include "config.h"
 #include "StructureIDTable.h"
 
-#include <limits.h>
-#include <wtf/Atomics.h>
+#include <wtf/OSAllocator.h>
 
 namespace JSC {
 
 StructureIDTable::StructureIDTable()
-    : m_firstFreeOffset(0)
-    , m_table(makeUniqueArray<StructureOrOffset>(s_initialSize))
-    , m_size(0)
-    , m_capacity(s_initialSize)
 {
+#if USE(JSVALUE64)
+    // Uncommitted address space is cheap, so ask for room for every possible StructureID and
+    // only settle for less where the address space is constrained.
+    for (m_reservedCapacity = s_maximumNumberOfStructures; m_reservedCapacity >= s_minimumReservedNumberOfStructures; m_reservedCapacity /= 2) {
+        m_reservation = PageReservation::reserve(m_reservedCapacity * sizeof(StructureOrOffset), OSAllocator::JSGCHeapPages);
+        if (m_reservation)
+            break;
+    }
+    RELEASE_ASSERT(m_reservation);
+    m_table = static_cast<StructureOrOffset*>(m_reservation.base());
+#endif
+
     // We pre-allocate the first offset so that the null Structure
     // can still be represented as the StructureID '0'.
     allocateID(0);
 }
 
-void StructureIDTable::resize(size_t newCapacity)
+StructureIDTable::~StructureIDTable()
 {
-    // Create the new table.
-    auto newTable = makeUniqueArray<StructureOrOffset>(newCapacity);
-
-    // Copy the contents of the old table to the new table.
-    memcpy(newTable.get(), table(), m_capacity * sizeof(StructureOrOffset));
-
-    // Store fence to make sure we've copied everything before doing the swap.
-    WTF::storeStoreFence();
+#if USE(JSVALUE64)
+    m_reservation.decommit(m_table, m_segments.size() * s_segmentSizeInBytes);
+    m_reservation.deallocate();
+#endif
+}
 
-    // Swap the old and new tables.
-    swap(m_table, newTable);
+void StructureIDTable::addSegment()
+{
+    // Running out of reserved address space is like running out of memory.
+    RELEASE_ASSERT(m_capacity + s_entriesPerSegment <= m_reservedCapacity);
 
-    // Put the old table (now labeled as new) into the list of old tables.
-    m_oldTables.append(WTFMove(newTable));
+    // Commit the new segment before publishing the new capacity. Entries that already
+    // exist never move, so there is nothing to copy and no old table to keep alive.
+    m_reservation.commit(table() + m_capacity, s_segmentSizeInBytes);
+    m_capacity += s_entriesPerSegment;
 
-    // Update the capacity.
-    m_capacity = newCapacity;
+    m_segments.append(Segment());
+    m_segments.last().isAvailable = true;
+    m_availableSegments.append(m_segments.size() - 1);
 }
 
-void StructureIDTable::flushOldTables()
+void StructureIDTable::releaseSegment(unsigned segmentIndex)
 {
-    m_oldTables.clear();
+    Segment& segment = m_segments[segmentIndex];
+    ASSERT(!segment.liveCount);
+
+    // The segment's free list lives in the pages we are about to drop, so start over
+    // with a fresh bump region. We only hint rather than decommit: a concurrent reader
+    // may still load a stale ID from this segment, and must see readable memory.
+    segment.firstFreeOffset = 0;
+    segment.bumpCount = 0;
+    segment.isReleased = true;
+    OSAllocator::hintMemoryNotNeededSoon(table() + segmentIndex * s_entriesPerSegment, s_segmentSizeInBytes);
+    m_releasedSegmentCount++;
 }
 
 StructureID StructureIDTable::allocateID(Structure* structure)
 {
 #if USE(JSVALUE64)
-    if (!m_firstFreeOffset) {
-        RELEASE_ASSERT(m_capacity <= UINT_MAX);
-        if (m_size == m_capacity)
-            resize(m_capacity * 2);
-        ASSERT(m_size < m_capacity);
-
-        StructureOrOffset newEntry;
-        newEntry.structure = structure;
-
-        if (m_size == s_unusedID) {
-            m_size++;
-            return allocateID(structure);
+    while (true) {
+        if (m_availableSegments.isEmpty())
+            addSegment();
+
+        unsigned segmentIndex = m_availableSegments.last();
+        Segment& segment = m_segments[segmentIndex];
+
+        StructureID result;
+        if (segment.firstFreeOffset) {
+            result = segment.firstFreeOffset;
+            segment.firstFreeOffset = table()[result].offset;
+        } else if (segment.bumpCount < s_entriesPerSegment)
+            result = segmentIndex * s_entriesPerSegment + segment.bumpCount++;
+        else {
+            segment.isAvailable = false;
+            m_availableSegments.removeLast();
+            continue;
+        }
+
+        if (segment.isReleased) {
+            segment.isReleased = false;
+            m_releasedSegmentCount--;
         }
+        segment.liveCount++;
 
-        StructureID result = m_size;
-        table()[result] = newEntry;
-        m_size++;
+        table()[result].structure = structure;
+        m_liveIDCount++;
+        ASSERT(result < m_capacity);
         ASSERT(!isNuked(result));
         return result;
     }
-
-    ASSERT(m_firstFreeOffset != s_unusedID);
-
-    StructureID result = m_firstFreeOffset;
-    m_firstFreeOffset = table()[m_firstFreeOffset].offset;
-    table()[result].structure = structure;
-    ASSERT(!isNuked(result));
-    return result;
 #else
     ASSERT(!isNuked(structure));
+    m_liveIDCount++;
     return structure;
 #endif
 }
@@ -108,13 +131,36 @@ StructureID StructureIDTable::allocateID(Structure* structure)
 void StructureIDTable::deallocateID(Structure* structure, StructureID structureID)
 {
 #if USE(JSVALUE64)
-    ASSERT(structureID != s_unusedID);
+    ASSERT(structureID);
+    ASSERT(structureID < m_capacity);
     RELEASE_ASSERT(table()[structureID].structure == structure);
-    table()[structureID].offset = m_firstFreeOffset;
-    m_firstFreeOffset = structureID;
+
+    unsigned segmentIndex = structureID / s_entriesPerSegment;
+    Segment& segment = m_segments[segmentIndex];
+    table()[structureID].offset = segment.firstFreeOffset;
+    segment.firstFreeOffset = structureID;
+    m_liveIDCount--;
+
+    // Only give an empty segment back when some other segment can take the next
+    // allocations. Otherwise churn would release and fault the same pages back in over
+    // and over. A released segment goes to the bottom of the stack so it is reused last.
+    bool shouldRelease = !--segment.liveCount
+        && !m_availableSegments.isEmpty()
+        && m_availableSegments.last() != segmentIndex;
+    if (shouldRelease)
+        releaseSegment(segmentIndex);
+
+    if (!segment.isAvailable) {
+        segment.isAvailable = true;
+        if (shouldRelease)
+            m_availableSegments.insert(0, segmentIndex);
+        else
+            m_availableSegments.append(segmentIndex);
+    }
 #else
     UNUSED_PARAM(structure);
     UNUSED_PARAM(structureID);
+    m_liveIDCount--;
 #endif
 }
 
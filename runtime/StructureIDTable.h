@@ -26,7 +26,7 @@
 #pragma once
 
 #include "UnusedPointer.h"
-#include <wtf/UniqueArray.h>
+#include <wtf/PageReservation.h>
 #include <wtf/Vector.h>
 
 namespace JSC {
@@ -79,10 +79,16 @@ inline StructureID decontaminate(StructureID id)
 }
 #endif
 
+// The table is a single virtual reservation that is committed one segment at a time, so
+// growing it never moves existing entries and concurrent readers (compiler threads and the
+// concurrent marker) can keep using the base pointer they loaded. Each segment keeps its
+// own free list so that a segment whose IDs have all been freed can hand its pages back to
+// the OS.
 class StructureIDTable {
     friend class LLIntOffsetsExtractor;
 public:
     StructureIDTable();
+    ~StructureIDTable();
 
     void** base() { return reinterpret_cast<void**>(&m_table); }
 
@@ -90,13 +96,24 @@ public:
     void deallocateID(Structure*, StructureID);
     StructureID allocateID(Structure*);
 
-    void flushOldTables();
-    
-    size_t size() const { return m_size; }
+    // Every valid StructureID is below size().
+    size_t size() const { return m_capacity; }
+    // Number of IDs in use, including the reserved null ID.
+    size_t liveIDCount() const { return m_liveIDCount; }
+    // Number of IDs in committed segments that are not in use.
+    size_t freeIDCount() const
+    {
+#if USE(JSVALUE64)
+        return m_capacity - m_liveIDCount;
+#else
+        // StructureIDs are Structure pointers, so there is nothing to be free.
+        return 0;
+#endif
+    }
+    size_t capacity() const { return m_capacity; }
+    size_t releasedSegmentCount() const { return m_releasedSegmentCount; }
 
 private:
-    void resize(size_t newCapacity);
-
     union StructureOrOffset {
         WTF_MAKE_FAST_ALLOCATED;
     public:
@@ -104,20 +121,43 @@ private:
         StructureID offset;
     };
 
-    StructureOrOffset* table() const { return m_table.get(); }
-    
-    static const size_t s_initialSize = 256;
+    struct Segment {
+        // Head of this segment's free list, or 0 if it is empty. ID 0 is never freed.
+        StructureID firstFreeOffset { 0 };
+        unsigned liveCount { 0 };
+        // Entries at or above this index have never been handed out since the segment
+        // was last released.
+        unsigned bumpCount { 0 };
+        bool isAvailable { false };
+        bool isReleased { false };
+    };
+
+    StructureOrOffset* table() const { return m_table; }
+
+    void addSegment();
+    void releaseSegment(unsigned segmentIndex);
+
+    static const size_t s_segmentSizeInBytes = 64 * KB;
+    static const unsigned s_entriesPerSegment = s_segmentSizeInBytes / sizeof(StructureOrOffset);
+    // Every ID without the nuked bit. The reservation is smaller if the address space is tight.
+    static const size_t s_maximumNumberOfStructures = static_cast<size_t>(1) << 31;
+    static const size_t s_minimumReservedNumberOfStructures = 1 << 24;
 
-    Vector<UniqueArray<StructureOrOffset>> m_oldTables;
+    StructureOrOffset* m_table { nullptr };
 
-    uint32_t m_firstFreeOffset;
-    UniqueArray<StructureOrOffset> m_table;
+    PageReservation m_reservation;
+    Vector<Segment> m_segments;
+    // Segments that may still have free entries. The last one is allocated from first.
+    Vector<unsigned> m_availableSegments;
 
-    size_t m_size;
-    size_t m_capacity;
+    size_t m_liveIDCount { 0 };
+    size_t m_capacity { 0 };
+    size_t m_reservedCapacity { 0 };
+    size_t m_releasedSegmentCount { 0 };
 
 #if USE(JSVALUE64)
     static const StructureID s_unusedID = unusedPointer;
+    static_assert(s_unusedID >= s_maximumNumberOfStructures, "The unused ID must never be handed out");
 #endif
 };
 
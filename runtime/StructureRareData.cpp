@@ -27,6 +27,8 @@
 #include "StructureRareData.h"
 
 #include "AdaptiveInferredPropertyValueWatchpointBase.h"
+#include "JSImmutableButterfly.h"
+#include "JSONObject.h"
 #include "JSPropertyNameEnumerator.h"
 #include "JSString.h"
 #include "JSCInlines.h"
@@ -70,6 +72,8 @@ void StructureRareData::visitChildren(JSCell* cell, SlotVisitor& visitor)
     visitor.append(thisObject->m_previous);
     visitor.append(thisObject->m_objectToStringValue);
     visitor.append(thisObject->m_cachedPropertyNameEnumerator);
+    visitor.append(thisObject->m_cachedOwnKeys);
+    visitor.append(thisObject->m_cachedOwnPropertyNames);
 }
 
 JSPropertyNameEnumerator* StructureRareData::cachedPropertyNameEnumerator() const
@@ -82,6 +86,31 @@ void StructureRareData::setCachedPropertyNameEnumerator(VM& vm, JSPropertyNameEn
     m_cachedPropertyNameEnumerator.set(vm, this, enumerator);
 }
 
+CachedJSONPropertyList* StructureRareData::cachedJSONPropertyList() const
+{
+    return m_cachedJSONPropertyList.get();
+}
+
+void StructureRareData::setCachedJSONPropertyList(Ref<CachedJSONPropertyList>&& propertyList)
+{
+    m_cachedJSONPropertyList = WTFMove(propertyList);
+}
+
+JSImmutableButterfly* StructureRareData::cachedOwnKeys(DontEnumPropertiesMode mode) const
+{
+    if (mode == DontEnumPropertiesMode::Include)
+        return m_cachedOwnPropertyNames.get();
+    return m_cachedOwnKeys.get();
+}
+
+void StructureRareData::setCachedOwnKeys(VM& vm, DontEnumPropertiesMode mode, JSImmutableButterfly* ownKeys)
+{
+    if (mode == DontEnumPropertiesMode::Include)
+        m_cachedOwnPropertyNames.set(vm, this, ownKeys);
+    else
+        m_cachedOwnKeys.set(vm, this, ownKeys);
+}
+
 // ----------- Object.prototype.toString() helper watchpoint classes -----------
 
 class ObjectToStringAdaptiveInferredPropertyValueWatchpoint : public AdaptiveInferredPropertyValueWatchpointBase {
@@ -26,6 +26,7 @@
 #pragma once
 
 #include "ClassInfo.h"
+#include "EnumerationMode.h"
 #include "JSCast.h"
 #include "JSTypeInfo.h"
 #include "PropertyOffset.h"
@@ -33,6 +34,8 @@
 
 namespace JSC {
 
+class CachedJSONPropertyList;
+class JSImmutableButterfly;
 class JSPropertyNameEnumerator;
 class Structure;
 class ObjectToStringAdaptiveStructureWatchpoint;
@@ -68,6 +71,12 @@ public:
     JSPropertyNameEnumerator* cachedPropertyNameEnumerator() const;
     void setCachedPropertyNameEnumerator(VM&, JSPropertyNameEnumerator*);
 
+    CachedJSONPropertyList* cachedJSONPropertyList() const;
+    void setCachedJSONPropertyList(Ref<CachedJSONPropertyList>&&);
+
+    JSImmutableButterfly* cachedOwnKeys(DontEnumPropertiesMode) const;
+    void setCachedOwnKeys(VM&, DontEnumPropertiesMode, JSImmutableButterfly*);
+
     Box<InlineWatchpointSet> copySharedPolyProtoWatchpoint() const { return m_polyProtoWatchpoint; }
     const Box<InlineWatchpointSet>& sharedPolyProtoWatchpoint() const { return m_polyProtoWatchpoint; }
     void setSharedPolyProtoWatchpoint(Box<InlineWatchpointSet>&& sharedPolyProtoWatchpoint) { m_polyProtoWatchpoint = WTFMove(sharedPolyProtoWatchpoint); }
@@ -87,6 +96,10 @@ private:
     WriteBarrier<Structure> m_previous;
     WriteBarrier<JSString> m_objectToStringValue;
     WriteBarrier<JSPropertyNameEnumerator> m_cachedPropertyNameEnumerator;
+    RefPtr<CachedJSONPropertyList> m_cachedJSONPropertyList;
+    // Own string keys in Object.keys() order, with (Include) and without (Exclude) non-enumerable ones.
+    WriteBarrier<JSImmutableButterfly> m_cachedOwnKeys;
+    WriteBarrier<JSImmutableButterfly> m_cachedOwnPropertyNames;
 
     typedef HashMap<PropertyOffset, RefPtr<WatchpointSet>, WTF::IntHash<PropertyOffset>, WTF::UnsignedWithZeroKeyHashTraits<PropertyOffset>> PropertyWatchpointMap;
     std::unique_ptr<PropertyWatchpointMap> m_replacementWatchpointSets;
@@ -146,6 +146,7 @@
 #include "VMInlines.h"
 #include "VMInspector.h"
 #include "VariableEnvironment.h"
+#include "WasmModule.h"
 #include "WasmWorklist.h"
 #include "Watchdog.h"
 #include "WeakGCMapInlines.h"
@@ -776,6 +777,9 @@ void VM::deleteAllCode(DeleteAllCodeEffort effort)
     whenIdle([=] () {
         m_codeCache->clear();
         m_regExpCache->deleteAllCode();
+#if ENABLE(WEBASSEMBLY)
+        Wasm::Module::clearCache();
+#endif
         heap.deleteAllCodeBlocks(effort);
         heap.deleteAllUnlinkedCodeBlocks(effort);
         heap.reportAbandonedObjectGraph();
@@ -797,8 +801,15 @@ void VM::shrinkFootprintWhenIdle()
 SourceProviderCache* VM::addSourceProviderCache(SourceProvider* sourceProvider)
 {
     auto addResult = sourceProviderCacheMap.add(sourceProvider, nullptr);
-    if (addResult.isNewEntry)
+    if (addResult.isNewEntry) {
         addResult.iterator->value = adoptRef(new SourceProviderCache);
+        if (SourceProvider* previousVersion = sourceProvider->previousVersion()) {
+            auto previousCache = sourceProviderCacheMap.find(previousVersion);
+            if (previousCache != sourceProviderCacheMap.end() && Options::useSourceProviderCache())
+                addResult.iterator->value->addUnchangedItems(*previousCache->value, *previousVersion, *sourceProvider, sourceProvider->editFromPreviousVersion());
+            sourceProvider->clearPreviousVersion();
+        }
+    }
     return addResult.iterator->value.get();
 }
 
@@ -1099,13 +1110,13 @@ void VM::dumpTypeProfilerData()
 
 void VM::queueMicrotask(JSGlobalObject& globalObject, Ref<Microtask>&& task)
 {
-    m_microtaskQueue.append(std::make_unique<QueuedTask>(*this, &globalObject, WTFMove(task)));
+    m_microtaskQueue.append(QueuedTask(*this, &globalObject, WTFMove(task)));
 }
 
 void VM::drainMicrotasks()
 {
     while (!m_microtaskQueue.isEmpty())
-        m_microtaskQueue.takeFirst()->run();
+        m_microtaskQueue.takeFirst().run();
 }
 
 void QueuedTask::run()
@@ -211,6 +211,9 @@ public:
     {
     }
 
+    QueuedTask(QueuedTask&&) = default;
+    QueuedTask& operator=(QueuedTask&&) = default;
+
 private:
     Strong<JSGlobalObject> m_globalObject;
     Ref<Microtask> m_microtask;
@@ -970,7 +973,7 @@ private:
     FunctionHasExecutedCache m_functionHasExecutedCache;
     std::unique_ptr<ControlFlowProfiler> m_controlFlowProfiler;
     unsigned m_controlFlowProfilerEnabledCount;
-    Deque<std::unique_ptr<QueuedTask>> m_microtaskQueue;
+    Deque<QueuedTask> m_microtaskQueue;
     MallocPtr<EncodedJSValue> m_exceptionFuzzBuffer;
     VMTraps m_traps;
     RefPtr<Watchdog> m_watchdog;
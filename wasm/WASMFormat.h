@@ -61,6 +61,7 @@ inline bool isValueType(Type type)
     case I64:
     case F32:
     case F64:
+    case V128:
         return true;
     default:
         break;
@@ -27,6 +27,7 @@
 
 #if ENABLE(WEBASSEMBLY)
 
+#include "Options.h"
 #include "WasmParser.h"
 #include <wtf/DataLog.h>
 
@@ -56,14 +57,24 @@ public:
     };
 
     OpType currentOpcode() const { return m_currentOpcode; }
+    // The 0xfc, 0xfd and 0xfe prefixes are not valid OpTypes. When one is the current opcode, the
+    // opcode that followed it is currentPrefixedOpcode().
+    bool currentOpcodeIsPrefixed() const { return m_currentOpcode == miscOpcodePrefix || m_currentOpcode == simdOpcodePrefix || m_currentOpcode == atomicOpcodePrefix; }
+    uint32_t currentPrefixedOpcode() const { return m_currentPrefixedOpcode; }
     size_t currentOpcodeStartingOffset() const { return m_currentOpcodeStartingOffset; }
 
+    const ExpressionList& expressionStack() const { return m_expressionStack; }
+    const Vector<ControlEntry>& controlStack() const { return m_controlStack; }
+
 private:
     static const bool verbose = false;
 
     PartialResult WARN_UNUSED_RETURN parseBody();
     PartialResult WARN_UNUSED_RETURN parseExpression();
     PartialResult WARN_UNUSED_RETURN parseUnreachableExpression();
+    PartialResult WARN_UNUSED_RETURN parseMiscExpression();
+    PartialResult WARN_UNUSED_RETURN parseSIMDExpression();
+    PartialResult WARN_UNUSED_RETURN parseAtomicExpression();
     PartialResult WARN_UNUSED_RETURN unifyControl(Vector<ExpressionType>&, unsigned level);
 
 #define WASM_TRY_POP_EXPRESSION_STACK_INTO(result, what) do {                               \
@@ -88,6 +99,7 @@ private:
     const ModuleInformation& m_info;
 
     OpType m_currentOpcode;
+    uint32_t m_currentPrefixedOpcode { 0 };
     size_t m_currentOpcodeStartingOffset { 0 };
 
     unsigned m_unreachableBlocks { 0 };
@@ -137,6 +149,21 @@ auto FunctionParser<Context>::parseBody() -> PartialResult
     while (m_controlStack.size()) {
         m_currentOpcodeStartingOffset = m_offset;
         WASM_PARSER_FAIL_IF(!parseUInt8(op), "can't decode opcode");
+        if (op == miscOpcodePrefix) {
+            m_currentOpcode = static_cast<OpType>(op);
+            WASM_FAIL_IF_HELPER_FAILS(parseMiscExpression());
+            continue;
+        }
+        if (op == simdOpcodePrefix) {
+            m_currentOpcode = static_cast<OpType>(op);
+            WASM_FAIL_IF_HELPER_FAILS(parseSIMDExpression());
+            continue;
+        }
+        if (op == atomicOpcodePrefix) {
+            m_currentOpcode = static_cast<OpType>(op);
+            WASM_FAIL_IF_HELPER_FAILS(parseAtomicExpression());
+            continue;
+        }
         WASM_PARSER_FAIL_IF(!isValidOpType(op), "invalid opcode ", op);
 
         m_currentOpcode = static_cast<OpType>(op);
@@ -381,7 +408,9 @@ auto FunctionParser<Context>::parseExpression() -> PartialResult
     case Loop: {
         Type inlineSignature;
         WASM_PARSER_FAIL_IF(!parseResultType(inlineSignature), "can't get loop's inline signature");
-        m_controlStack.append({ WTFMove(m_expressionStack), m_context.addLoop(inlineSignature) });
+        // The context may look at the enclosing expression stack, so it has to see it before it moves.
+        ControlType loop = m_context.addLoop(inlineSignature);
+        m_controlStack.append({ WTFMove(m_expressionStack), WTFMove(loop) });
         m_expressionStack = ExpressionList();
         return { };
     }
@@ -524,6 +553,306 @@ auto FunctionParser<Context>::parseExpression() -> PartialResult
     return { };
 }
 
+// Prefixed opcodes can't end a block, so this handles both reachable and unreachable code.
+template<typename Context>
+auto FunctionParser<Context>::parseMiscExpression() -> PartialResult
+{
+    uint32_t miscOp;
+    WASM_PARSER_FAIL_IF(!parseVarUInt32(miscOp), "can't decode 0xfc prefixed opcode");
+    m_currentPrefixedOpcode = miscOp;
+
+    switch (static_cast<MiscOpType>(miscOp)) {
+    case MiscOpType::MemoryCopy: {
+        uint8_t reserved;
+        WASM_PARSER_FAIL_IF(!parseVarUInt1(reserved), "can't parse destination memory index for memory.copy");
+        WASM_PARSER_FAIL_IF(reserved != 0, "destination memory index for memory.copy must be zero");
+        WASM_PARSER_FAIL_IF(!parseVarUInt1(reserved), "can't parse source memory index for memory.copy");
+        WASM_PARSER_FAIL_IF(reserved != 0, "source memory index for memory.copy must be zero");
+        if (m_unreachableBlocks)
+            return { };
+
+        WASM_PARSER_FAIL_IF(!m_info.memory, "memory.copy is only valid if a memory is defined or imported");
+        ExpressionType destination;
+        ExpressionType source;
+        ExpressionType count;
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(count, "expect an i32 count argument to memory.copy on the stack");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(source, "expect an i32 source argument to memory.copy on the stack");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(destination, "expect an i32 destination argument to memory.copy on the stack");
+        WASM_TRY_ADD_TO_CONTEXT(addMemoryCopy(destination, source, count));
+        return { };
+    }
+
+    case MiscOpType::MemoryFill: {
+        uint8_t reserved;
+        WASM_PARSER_FAIL_IF(!parseVarUInt1(reserved), "can't parse memory index for memory.fill");
+        WASM_PARSER_FAIL_IF(reserved != 0, "memory index for memory.fill must be zero");
+        if (m_unreachableBlocks)
+            return { };
+
+        WASM_PARSER_FAIL_IF(!m_info.memory, "memory.fill is only valid if a memory is defined or imported");
+        ExpressionType destination;
+        ExpressionType value;
+        ExpressionType count;
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(count, "expect an i32 count argument to memory.fill on the stack");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(value, "expect an i32 value argument to memory.fill on the stack");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(destination, "expect an i32 destination argument to memory.fill on the stack");
+        WASM_TRY_ADD_TO_CONTEXT(addMemoryFill(destination, value, count));
+        return { };
+    }
+    }
+
+    WASM_PARSER_FAIL_IF(true, "unsupported 0xfc prefixed opcode ", miscOp);
+}
+
+// Like parseMiscExpression, this handles both reachable and unreachable code.
+template<typename Context>
+auto FunctionParser<Context>::parseSIMDExpression() -> PartialResult
+{
+    uint32_t simdOp;
+    WASM_PARSER_FAIL_IF(!parseVarUInt32(simdOp), "can't decode 0xfd prefixed opcode");
+    m_currentPrefixedOpcode = simdOp;
+    WASM_PARSER_FAIL_IF(!isValidSIMDOpType(simdOp), "unsupported 0xfd prefixed opcode ", simdOp);
+    SIMDOpType op = static_cast<SIMDOpType>(simdOp);
+
+    switch (simdCategory(op)) {
+    case SIMDOpCategory::Load: {
+        uint32_t alignment;
+        uint32_t offset;
+        WASM_PARSER_FAIL_IF(!parseVarUInt32(alignment), "can't get v128.load alignment");
+        WASM_PARSER_FAIL_IF(alignment > 4, "byte alignment ", 1ull << alignment, " exceeds v128.load's natural alignment 16");
+        WASM_PARSER_FAIL_IF(!parseVarUInt32(offset), "can't get v128.load offset");
+        if (m_unreachableBlocks)
+            return { };
+
+        ExpressionType pointer;
+        ExpressionType result;
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(pointer, "v128.load pointer");
+        WASM_TRY_ADD_TO_CONTEXT(addSIMDLoad(pointer, offset, result));
+        m_expressionStack.append(result);
+        return { };
+    }
+
+    case SIMDOpCategory::Store: {
+        uint32_t alignment;
+        uint32_t offset;
+        WASM_PARSER_FAIL_IF(!parseVarUInt32(alignment), "can't get v128.store alignment");
+        WASM_PARSER_FAIL_IF(alignment > 4, "byte alignment ", 1ull << alignment, " exceeds v128.store's natural alignment 16");
+        WASM_PARSER_FAIL_IF(!parseVarUInt32(offset), "can't get v128.store offset");
+        if (m_unreachableBlocks)
+            return { };
+
+        ExpressionType value;
+        ExpressionType pointer;
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(value, "v128.store value");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(pointer, "v128.store pointer");
+        WASM_TRY_ADD_TO_CONTEXT(addSIMDStore(pointer, value, offset));
+        return { };
+    }
+
+    case SIMDOpCategory::Const: {
+        v128_t constant;
+        for (unsigned i = 0; i < 16; ++i)
+            WASM_PARSER_FAIL_IF(!parseUInt8(constant.u8x16[i]), "can't parse byte ", i, " of v128.const");
+        if (m_unreachableBlocks)
+            return { };
+
+        m_expressionStack.append(m_context.addSIMDConstant(constant));
+        return { };
+    }
+
+    case SIMDOpCategory::Shuffle: {
+        v128_t laneIndices;
+        for (unsigned i = 0; i < 16; ++i) {
+            WASM_PARSER_FAIL_IF(!parseUInt8(laneIndices.u8x16[i]), "can't parse lane index ", i, " of i8x16.shuffle");
+            WASM_PARSER_FAIL_IF(laneIndices.u8x16[i] >= 32, "i8x16.shuffle's lane index ", i, " is ", laneIndices.u8x16[i], ", which exceeds 31");
+        }
+        if (m_unreachableBlocks)
+            return { };
+
+        ExpressionType right;
+        ExpressionType left;
+        ExpressionType result;
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(right, "i8x16.shuffle right");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(left, "i8x16.shuffle left");
+        WASM_TRY_ADD_TO_CONTEXT(addSIMDShuffle(laneIndices, left, right, result));
+        m_expressionStack.append(result);
+        return { };
+    }
+
+    case SIMDOpCategory::ExtractLane:
+    case SIMDOpCategory::ReplaceLane: {
+        uint8_t laneIndex;
+        WASM_PARSER_FAIL_IF(!parseUInt8(laneIndex), "can't parse lane index for ", makeString(op));
+        WASM_PARSER_FAIL_IF(laneIndex >= laneCount(simdLane(op)), makeString(op), "'s lane index ", laneIndex, " exceeds its lane count ", laneCount(simdLane(op)));
+        if (m_unreachableBlocks)
+            return { };
+
+        ExpressionType result;
+        if (simdCategory(op) == SIMDOpCategory::ExtractLane) {
+            ExpressionType vector;
+            WASM_TRY_POP_EXPRESSION_STACK_INTO(vector, "extract_lane vector");
+            WASM_TRY_ADD_TO_CONTEXT(addSIMDExtractLane(op, laneIndex, vector, result));
+        } else {
+            ExpressionType scalar;
+            ExpressionType vector;
+            WASM_TRY_POP_EXPRESSION_STACK_INTO(scalar, "replace_lane scalar");
+            WASM_TRY_POP_EXPRESSION_STACK_INTO(vector, "replace_lane vector");
+            WASM_TRY_ADD_TO_CONTEXT(addSIMDReplaceLane(op, laneIndex, vector, scalar, result));
+        }
+        m_expressionStack.append(result);
+        return { };
+    }
+
+    case SIMDOpCategory::Splat:
+    case SIMDOpCategory::Unary:
+    case SIMDOpCategory::Reduce: {
+        if (m_unreachableBlocks)
+            return { };
+
+        ExpressionType value;
+        ExpressionType result;
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(value, "SIMD unary");
+        WASM_TRY_ADD_TO_CONTEXT(addSIMDUnary(op, value, result));
+        m_expressionStack.append(result);
+        return { };
+    }
+
+    case SIMDOpCategory::Binary:
+    case SIMDOpCategory::Shift: {
+        if (m_unreachableBlocks)
+            return { };
+
+        ExpressionType right;
+        ExpressionType left;
+        ExpressionType result;
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(right, "SIMD binary right");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(left, "SIMD binary left");
+        WASM_TRY_ADD_TO_CONTEXT(addSIMDBinary(op, left, right, result));
+        m_expressionStack.append(result);
+        return { };
+    }
+
+    case SIMDOpCategory::BitSelect: {
+        if (m_unreachableBlocks)
+            return { };
+
+        ExpressionType mask;
+        ExpressionType right;
+        ExpressionType left;
+        ExpressionType result;
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(mask, "v128.bitselect mask");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(right, "v128.bitselect right");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(left, "v128.bitselect left");
+        WASM_TRY_ADD_TO_CONTEXT(addSIMDBitSelect(left, right, mask, result));
+        m_expressionStack.append(result);
+        return { };
+    }
+    }
+
+    ASSERT_NOT_REACHED();
+    return { };
+}
+
+// Like parseMiscExpression, this handles both reachable and unreachable code.
+template<typename Context>
+auto FunctionParser<Context>::parseAtomicExpression() -> PartialResult
+{
+    uint32_t atomicOp;
+    WASM_PARSER_FAIL_IF(!Options::useWebAssemblyThreads(), "0xfe prefixed opcodes require the threads proposal, which is disabled");
+    WASM_PARSER_FAIL_IF(!parseVarUInt32(atomicOp), "can't decode 0xfe prefixed opcode");
+    m_currentPrefixedOpcode = atomicOp;
+    WASM_PARSER_FAIL_IF(!isValidAtomicOpType(atomicOp), "unsupported 0xfe prefixed opcode ", atomicOp);
+    AtomicOpType op = static_cast<AtomicOpType>(atomicOp);
+
+    if (atomicCategory(op) == AtomicOpCategory::Fence) {
+        uint8_t reserved;
+        WASM_PARSER_FAIL_IF(!parseUInt8(reserved), "can't parse the reserved byte of atomic.fence");
+        WASM_PARSER_FAIL_IF(reserved, "the reserved byte of atomic.fence must be zero");
+        if (m_unreachableBlocks)
+            return { };
+
+        WASM_TRY_ADD_TO_CONTEXT(addAtomicFence());
+        return { };
+    }
+
+    // Unlike other memory accesses, an atomic access's alignment hint must be exactly its natural
+    // alignment, and misaligned addresses trap at runtime.
+    uint32_t alignment;
+    uint32_t offset;
+    WASM_PARSER_FAIL_IF(!parseVarUInt32(alignment), "can't get ", makeString(op), " alignment");
+    WASM_PARSER_FAIL_IF(alignment > 3 || (1u << alignment) != atomicAccessBytes(op), makeString(op), "'s alignment must be its natural alignment ", atomicAccessBytes(op));
+    WASM_PARSER_FAIL_IF(!parseVarUInt32(offset), "can't get ", makeString(op), " offset");
+    if (m_unreachableBlocks)
+        return { };
+
+    WASM_PARSER_FAIL_IF(!m_info.memory, makeString(op), " is only valid if a memory is defined or imported");
+    ExpressionType pointer;
+    ExpressionType result;
+
+    switch (atomicCategory(op)) {
+    case AtomicOpCategory::Load: {
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(pointer, "atomic load pointer");
+        WASM_TRY_ADD_TO_CONTEXT(addAtomicLoad(op, pointer, offset, result));
+        m_expressionStack.append(result);
+        return { };
+    }
+
+    case AtomicOpCategory::Store: {
+        ExpressionType value;
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(value, "atomic store value");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(pointer, "atomic store pointer");
+        WASM_TRY_ADD_TO_CONTEXT(addAtomicStore(op, pointer, value, offset));
+        return { };
+    }
+
+    case AtomicOpCategory::RMW: {
+        ExpressionType value;
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(value, "atomic rmw value");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(pointer, "atomic rmw pointer");
+        WASM_TRY_ADD_TO_CONTEXT(addAtomicBinaryRMW(op, pointer, value, offset, result));
+        m_expressionStack.append(result);
+        return { };
+    }
+
+    case AtomicOpCategory::CompareExchange: {
+        ExpressionType replacement;
+        ExpressionType expected;
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(replacement, "atomic cmpxchg replacement");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(expected, "atomic cmpxchg expected");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(pointer, "atomic cmpxchg pointer");
+        WASM_TRY_ADD_TO_CONTEXT(addAtomicCompareExchange(op, pointer, expected, replacement, offset, result));
+        m_expressionStack.append(result);
+        return { };
+    }
+
+    case AtomicOpCategory::Wait: {
+        ExpressionType timeout;
+        ExpressionType expected;
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(timeout, "memory.atomic.wait timeout");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(expected, "memory.atomic.wait expected");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(pointer, "memory.atomic.wait pointer");
+        WASM_TRY_ADD_TO_CONTEXT(addAtomicWait(op, pointer, expected, timeout, offset, result));
+        m_expressionStack.append(result);
+        return { };
+    }
+
+    case AtomicOpCategory::Notify: {
+        ExpressionType count;
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(count, "memory.atomic.notify count");
+        WASM_TRY_POP_EXPRESSION_STACK_INTO(pointer, "memory.atomic.notify pointer");
+        WASM_TRY_ADD_TO_CONTEXT(addAtomicNotify(pointer, count, offset, result));
+        m_expressionStack.append(result);
+        return { };
+    }
+
+    case AtomicOpCategory::Fence:
+        break;
+    }
+
+    ASSERT_NOT_REACHED();
+    return { };
+}
+
 // FIXME: We should try to use the same decoder function for both unreachable and reachable code. https://bugs.webkit.org/show_bug.cgi?id=165965
 template<typename Context>
 auto FunctionParser<Context>::parseUnreachableExpression() -> PartialResult
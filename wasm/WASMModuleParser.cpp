@@ -29,6 +29,7 @@
 #if ENABLE(WEBASSEMBLY)
 
 #include "IdentifierInlines.h"
+#include "Options.h"
 #include "WasmMemoryInformation.h"
 #include "WasmNameSectionParser.h"
 #include "WasmOps.h"
@@ -126,6 +127,7 @@ auto ModuleParser::parseType() -> PartialResult
 
         for (unsigned i = 0; i < argumentCount; ++i) {
             Type argumentType;
+            WASM_PARSER_FAIL_IF(atV128Type(), i, "th argument Type is v128, which isn't supported in signatures yet");
             WASM_PARSER_FAIL_IF(!parseValueType(argumentType), "can't get ", i, "th argument Type");
             signature->argument(i) = argumentType;
         }
@@ -135,6 +137,7 @@ auto ModuleParser::parseType() -> PartialResult
         Type returnType;
         if (returnCount) {
             Type value;
+            WASM_PARSER_FAIL_IF(atV128Type(), i, "th Type's return value is v128, which isn't supported in signatures yet");
             WASM_PARSER_FAIL_IF(!parseValueType(value), "can't get ", i, "th Type's return value");
             returnType = static_cast<Type>(value);
         } else
@@ -237,15 +240,23 @@ auto ModuleParser::parseFunction() -> PartialResult
     return { };
 }
 
-auto ModuleParser::parseResizableLimits(uint32_t& initial, std::optional<uint32_t>& maximum) -> PartialResult
+auto ModuleParser::parseResizableLimits(uint32_t& initial, std::optional<uint32_t>& maximum, bool& isShared) -> PartialResult
 {
     ASSERT(!maximum);
 
+    // Bit 0 says a maximum is present, and bit 1, from the threads proposal, says the limits are shared.
+    static constexpr uint8_t hasMaximumFlag = 0x1;
+    static constexpr uint8_t isSharedFlag = 0x2;
+
     uint8_t flags;
-    WASM_PARSER_FAIL_IF(!parseVarUInt1(flags), "can't parse resizable limits flags");
+    WASM_PARSER_FAIL_IF(!parseUInt7(flags), "can't parse resizable limits flags");
+    WASM_PARSER_FAIL_IF(flags & ~(hasMaximumFlag | isSharedFlag), "resizable limits flags are invalid: ", flags);
+    isShared = flags & isSharedFlag;
+    WASM_PARSER_FAIL_IF(isShared && !Options::useWebAssemblyThreads(), "shared resizable limits require the threads proposal, which is disabled");
+    WASM_PARSER_FAIL_IF(isShared && !(flags & hasMaximumFlag), "shared resizable limits must have a maximum page count");
     WASM_PARSER_FAIL_IF(!parseVarUInt32(initial), "can't parse resizable limits initial page count");
 
-    if (flags) {
+    if (flags & hasMaximumFlag) {
         uint32_t maximumInt;
         WASM_PARSER_FAIL_IF(!parseVarUInt32(maximumInt), "can't parse resizable limits maximum page count");
         WASM_PARSER_FAIL_IF(initial > maximumInt, "resizable limits has a initial page count of ", initial, " which is greater than its maximum ", maximumInt);
@@ -267,9 +278,11 @@ auto ModuleParser::parseTableHelper(bool isImport) -> PartialResult
 
     uint32_t initial;
     std::optional<uint32_t> maximum;
-    PartialResult limits = parseResizableLimits(initial, maximum);
+    bool isShared;
+    PartialResult limits = parseResizableLimits(initial, maximum, isShared);
     if (UNLIKELY(!limits))
         return makeUnexpected(WTFMove(limits.error()));
+    WASM_PARSER_FAIL_IF(isShared, "Table can't be shared");
     WASM_PARSER_FAIL_IF(initial > maxTableEntries, "Table's initial page count of ", initial, " is too big, maximum ", maxTableEntries);
 
     ASSERT(!maximum || *maximum >= initial);
@@ -304,10 +317,11 @@ auto ModuleParser::parseMemoryHelper(bool isImport) -> PartialResult
 
     PageCount initialPageCount;
     PageCount maximumPageCount;
+    bool isShared;
     {
         uint32_t initial;
         std::optional<uint32_t> maximum;
-        PartialResult limits = parseResizableLimits(initial, maximum);
+        PartialResult limits = parseResizableLimits(initial, maximum, isShared);
         if (UNLIKELY(!limits))
             return makeUnexpected(WTFMove(limits.error()));
         ASSERT(!maximum || *maximum >= initial);
@@ -323,7 +337,7 @@ auto ModuleParser::parseMemoryHelper(bool isImport) -> PartialResult
     ASSERT(initialPageCount);
     ASSERT(!maximumPageCount || maximumPageCount >= initialPageCount);
 
-    m_info->memory = MemoryInformation(initialPageCount, maximumPageCount, isImport);
+    m_info->memory = MemoryInformation(initialPageCount, maximumPageCount, isShared, isImport);
     return { };
 }
 
@@ -555,6 +569,7 @@ auto ModuleParser::parseInitExpr(uint8_t& opcode, uint64_t& bitsOrImportNumber,
 auto ModuleParser::parseGlobalType(Global& global) -> PartialResult
 {
     uint8_t mutability;
+    WASM_PARSER_FAIL_IF(atV128Type(), "Global's value type is v128, which isn't supported for globals yet");
     WASM_PARSER_FAIL_IF(!parseValueType(global.type), "can't get Global's value type");
     WASM_PARSER_FAIL_IF(!parseVarUInt1(mutability), "can't get Global type's mutability");
     global.mutability = static_cast<Global::Mutability>(mutability);
@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2018 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "WasmOps.h"
+#include <cstdint>
+
+namespace JSC { namespace Wasm {
+
+// The immediates and the stack signature of an instruction follow from its category, where T is
+// the instruction's value type:
+//   Notify:          memarg; i32 i32 -> i32
+//   Wait:            memarg; i32 T i64 -> i32
+//   Fence:           a zero byte; () -> ()
+//   Load:            memarg; i32 -> T
+//   Store:           memarg; i32 T -> ()
+//   RMW:             memarg; i32 T -> T
+//   CompareExchange: memarg; i32 T T -> T
+// Accesses narrower than T zero extend the value they read.
+enum class AtomicOpCategory : uint8_t {
+    Notify,
+    Wait,
+    Fence,
+    Load,
+    Store,
+    RMW,
+    CompareExchange,
+};
+
+enum class AtomicRMWOp : uint8_t {
+    None,
+    Add,
+    Sub,
+    And,
+    Or,
+    Xor,
+    Xchg,
+};
+
+// The opcodes following the 0xfe prefix, numbered as in the threads proposal. The last two columns
+// are the value type and the number of bytes accessed, which is also the required alignment.
+#define FOR_EACH_WASM_ATOMIC_OP(macro) \
+    macro(MemoryAtomicNotify,     0x00, Notify,         None, I32,  4) \
+    macro(MemoryAtomicWait32,     0x01, Wait,           None, I32,  4) \
+    macro(MemoryAtomicWait64,     0x02, Wait,           None, I64,  8) \
+    macro(AtomicFence,            0x03, Fence,          None, Void, 0) \
+    macro(I32AtomicLoad,          0x10, Load,           None, I32,  4) \
+    macro(I64AtomicLoad,          0x11, Load,           None, I64,  8) \
+    macro(I32AtomicLoad8U,        0x12, Load,           None, I32,  1) \
+    macro(I32AtomicLoad16U,       0x13, Load,           None, I32,  2) \
+    macro(I64AtomicLoad8U,        0x14, Load,           None, I64,  1) \
+    macro(I64AtomicLoad16U,       0x15, Load,           None, I64,  2) \
+    macro(I64AtomicLoad32U,       0x16, Load,           None, I64,  4) \
+    macro(I32AtomicStore,         0x17, Store,          None, I32,  4) \
+    macro(I64AtomicStore,         0x18, Store,          None, I64,  8) \
+    macro(I32AtomicStore8,        0x19, Store,          None, I32,  1) \
+    macro(I32AtomicStore16,       0x1a, Store,          None, I32,  2) \
+    macro(I64AtomicStore8,        0x1b, Store,          None, I64,  1) \
+    macro(I64AtomicStore16,       0x1c, Store,          None, I64,  2) \
+    macro(I64AtomicStore32,       0x1d, Store,          None, I64,  4) \
+    macro(I32AtomicRmwAdd,        0x1e, RMW,            Add,  I32,  4) \
+    macro(I64AtomicRmwAdd,        0x1f, RMW,            Add,  I64,  8) \
+    macro(I32AtomicRmw8AddU,      0x20, RMW,            Add,  I32,  1) \
+    macro(I32AtomicRmw16AddU,     0x21, RMW,            Add,  I32,  2) \
+    macro(I64AtomicRmw8AddU,      0x22, RMW,            Add,  I64,  1) \
+    macro(I64AtomicRmw16AddU,     0x23, RMW,            Add,  I64,  2) \
+    macro(I64AtomicRmw32AddU,     0x24, RMW,            Add,  I64,  4) \
+    macro(I32AtomicRmwSub,        0x25, RMW,            Sub,  I32,  4) \
+    macro(I64AtomicRmwSub,        0x26, RMW,            Sub,  I64,  8) \
+    macro(I32AtomicRmw8SubU,      0x27, RMW,            Sub,  I32,  1) \
+    macro(I32AtomicRmw16SubU,     0x28, RMW,            Sub,  I32,  2) \
+    macro(I64AtomicRmw8SubU,      0x29, RMW,            Sub,  I64,  1) \
+    macro(I64AtomicRmw16SubU,     0x2a, RMW,            Sub,  I64,  2) \
+    macro(I64AtomicRmw32SubU,     0x2b, RMW,            Sub,  I64,  4) \
+    macro(I32AtomicRmwAnd,        0x2c, RMW,            And,  I32,  4) \
+    macro(I64AtomicRmwAnd,        0x2d, RMW,            And,  I64,  8) \
+    macro(I32AtomicRmw8AndU,      0x2e, RMW,            And,  I32,  1) \
+    macro(I32AtomicRmw16AndU,     0x2f, RMW,            And,  I32,  2) \
+    macro(I64AtomicRmw8AndU,      0x30, RMW,            And,  I64,  1) \
+    macro(I64AtomicRmw16AndU,     0x31, RMW,            And,  I64,  2) \
+    macro(I64AtomicRmw32AndU,     0x32, RMW,            And,  I64,  4) \
+    macro(I32AtomicRmwOr,         0x33, RMW,            Or,   I32,  4) \
+    macro(I64AtomicRmwOr,         0x34, RMW,            Or,   I64,  8) \
+    macro(I32AtomicRmw8OrU,       0x35, RMW,            Or,   I32,  1) \
+    macro(I32AtomicRmw16OrU,      0x36, RMW,            Or,   I32,  2) \
+    macro(I64AtomicRmw8OrU,       0x37, RMW,            Or,   I64,  1) \
+    macro(I64AtomicRmw16OrU,      0x38, RMW,            Or,   I64,  2) \
+    macro(I64AtomicRmw32OrU,      0x39, RMW,            Or,   I64,  4) \
+    macro(I32AtomicRmwXor,        0x3a, RMW,            Xor,  I32,  4) \
+    macro(I64AtomicRmwXor,        0x3b, RMW,            Xor,  I64,  8) \
+    macro(I32AtomicRmw8XorU,      0x3c, RMW,            Xor,  I32,  1) \
+    macro(I32AtomicRmw16XorU,     0x3d, RMW,            Xor,  I32,  2) \
+    macro(I64AtomicRmw8XorU,      0x3e, RMW,            Xor,  I64,  1) \
+    macro(I64AtomicRmw16XorU,     0x3f, RMW,            Xor,  I64,  2) \
+    macro(I64AtomicRmw32XorU,     0x40, RMW,            Xor,  I64,  4) \
+    macro(I32AtomicRmwXchg,       0x41, RMW,            Xchg, I32,  4) \
+    macro(I64AtomicRmwXchg,       0x42, RMW,            Xchg, I64,  8) \
+    macro(I32AtomicRmw8XchgU,     0x43, RMW,            Xchg, I32,  1) \
+    macro(I32AtomicRmw16XchgU,    0x44, RMW,            Xchg, I32,  2) \
+    macro(I64AtomicRmw8XchgU,     0x45, RMW,            Xchg, I64,  1) \
+    macro(I64AtomicRmw16XchgU,    0x46, RMW,            Xchg, I64,  2) \
+    macro(I64AtomicRmw32XchgU,    0x47, RMW,            Xchg, I64,  4) \
+    macro(I32AtomicRmwCmpxchg,    0x48, CompareExchange,None, I32,  4) \
+    macro(I64AtomicRmwCmpxchg,    0x49, CompareExchange,None, I64,  8) \
+    macro(I32AtomicRmw8CmpxchgU,  0x4a, CompareExchange,None, I32,  1) \
+    macro(I32AtomicRmw16CmpxchgU, 0x4b, CompareExchange,None, I32,  2) \
+    macro(I64AtomicRmw8CmpxchgU,  0x4c, CompareExchange,None, I64,  1) \
+    macro(I64AtomicRmw16CmpxchgU, 0x4d, CompareExchange,None, I64,  2) \
+    macro(I64AtomicRmw32CmpxchgU, 0x4e, CompareExchange,None, I64,  4)
+
+#define CREATE_ENUM_VALUE(name, id, category, rmwOp, type, accessBytes) name = id,
+enum class AtomicOpType : uint32_t {
+    FOR_EACH_WASM_ATOMIC_OP(CREATE_ENUM_VALUE)
+};
+#undef CREATE_ENUM_VALUE
+
+inline bool isValidAtomicOpType(uint32_t op)
+{
+    switch (op) {
+#define CREATE_CASE(name, id, category, rmwOp, type, accessBytes) case id:
+    FOR_EACH_WASM_ATOMIC_OP(CREATE_CASE)
+#undef CREATE_CASE
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+inline AtomicOpCategory atomicCategory(AtomicOpType op)
+{
+    switch (op) {
+#define CREATE_CASE(name, id, category, rmwOp, type, accessBytes) case AtomicOpType::name: return AtomicOpCategory::category;
+    FOR_EACH_WASM_ATOMIC_OP(CREATE_CASE)
+#undef CREATE_CASE
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return AtomicOpCategory::Fence;
+}
+
+inline AtomicRMWOp atomicRMWOp(AtomicOpType op)
+{
+    switch (op) {
+#define CREATE_CASE(name, id, category, rmwOp, type, accessBytes) case AtomicOpType::name: return AtomicRMWOp::rmwOp;
+    FOR_EACH_WASM_ATOMIC_OP(CREATE_CASE)
+#undef CREATE_CASE
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return AtomicRMWOp::None;
+}
+
+inline Type atomicValueType(AtomicOpType op)
+{
+    switch (op) {
+#define CREATE_CASE(name, id, category, rmwOp, type, accessBytes) case AtomicOpType::name: return type;
+    FOR_EACH_WASM_ATOMIC_OP(CREATE_CASE)
+#undef CREATE_CASE
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return Void;
+}
+
+inline uint32_t atomicAccessBytes(AtomicOpType op)
+{
+    switch (op) {
+#define CREATE_CASE(name, id, category, rmwOp, type, accessBytes) case AtomicOpType::name: return accessBytes;
+    FOR_EACH_WASM_ATOMIC_OP(CREATE_CASE)
+#undef CREATE_CASE
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return 0;
+}
+
+inline const char* makeString(AtomicOpType op)
+{
+    switch (op) {
+#define CREATE_CASE(name, id, category, rmwOp, type, accessBytes) case AtomicOpType::name: return #name;
+    FOR_EACH_WASM_ATOMIC_OP(CREATE_CASE)
+#undef CREATE_CASE
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return nullptr;
+}
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
@@ -29,10 +29,13 @@
 #if ENABLE(WEBASSEMBLY)
 
 #include "AllowMacroScratchRegisterUsageIf.h"
+#include "B3ArgumentRegValue.h"
+#include "B3AtomicValue.h"
 #include "B3BasicBlockInlines.h"
 #include "B3CCallValue.h"
 #include "B3Compile.h"
 #include "B3ConstPtrValue.h"
+#include "B3FenceValue.h"
 #include "B3FixSSA.h"
 #include "B3Generate.h"
 #include "B3InsertionSet.h"
@@ -62,6 +65,7 @@
 #include "WasmThunks.h"
 #include <limits>
 #include <wtf/Optional.h>
+#include <wtf/ParkingLot.h>
 #include <wtf/StdLibExtras.h>
 
 void dumpProcedure(void* ptr)
@@ -80,6 +84,10 @@ static const bool verbose = false;
 }
 }
 
+// v128 values are copied as two 64-bit halves.
+static constexpr int32_t v128Bytes = sizeof(v128_t);
+static constexpr int32_t v128HalfBytes = sizeof(uint64_t);
+
 class B3IRGenerator {
 public:
     struct ControlData {
@@ -177,7 +185,7 @@ public:
             return fail(__VA_ARGS__);             \
     } while (0)
 
-    B3IRGenerator(const ModuleInformation&, Procedure&, InternalFunction*, Vector<UnlinkedWasmToWasmCall>&, MemoryMode, CompilationMode, unsigned functionIndex, TierUpCount*, ThrowWasmException);
+    B3IRGenerator(const ModuleInformation&, Procedure&, InternalFunction*, Vector<UnlinkedWasmToWasmCall>&, MemoryMode, CompilationMode, unsigned functionIndex, TierUpCount*, ThrowWasmException, uint64_t* callCount, uint32_t loopIndexForOSREntry);
 
     PartialResult WARN_UNUSED_RETURN addArguments(const Signature&);
     PartialResult WARN_UNUSED_RETURN addLocal(Type, uint32_t);
@@ -196,6 +204,8 @@ public:
     PartialResult WARN_UNUSED_RETURN store(StoreOpType, ExpressionType pointer, ExpressionType value, uint32_t offset);
     PartialResult WARN_UNUSED_RETURN addGrowMemory(ExpressionType delta, ExpressionType& result);
     PartialResult WARN_UNUSED_RETURN addCurrentMemory(ExpressionType& result);
+    PartialResult WARN_UNUSED_RETURN addMemoryCopy(ExpressionType destination, ExpressionType source, ExpressionType count);
+    PartialResult WARN_UNUSED_RETURN addMemoryFill(ExpressionType destination, ExpressionType value, ExpressionType count);
 
     // Basic operators
     template<OpType>
@@ -204,6 +214,26 @@ public:
     PartialResult WARN_UNUSED_RETURN addOp(ExpressionType left, ExpressionType right, ExpressionType& result);
     PartialResult WARN_UNUSED_RETURN addSelect(ExpressionType condition, ExpressionType nonZero, ExpressionType zero, ExpressionType& result);
 
+    // SIMD
+    PartialResult WARN_UNUSED_RETURN addSIMDLoad(ExpressionType pointer, uint32_t offset, ExpressionType& result);
+    PartialResult WARN_UNUSED_RETURN addSIMDStore(ExpressionType pointer, ExpressionType value, uint32_t offset);
+    ExpressionType addSIMDConstant(const v128_t&);
+    PartialResult WARN_UNUSED_RETURN addSIMDShuffle(const v128_t& laneIndices, ExpressionType left, ExpressionType right, ExpressionType& result);
+    PartialResult WARN_UNUSED_RETURN addSIMDExtractLane(SIMDOpType, uint8_t laneIndex, ExpressionType vector, ExpressionType& result);
+    PartialResult WARN_UNUSED_RETURN addSIMDReplaceLane(SIMDOpType, uint8_t laneIndex, ExpressionType vector, ExpressionType scalar, ExpressionType& result);
+    PartialResult WARN_UNUSED_RETURN addSIMDUnary(SIMDOpType, ExpressionType value, ExpressionType& result);
+    PartialResult WARN_UNUSED_RETURN addSIMDBinary(SIMDOpType, ExpressionType left, ExpressionType right, ExpressionType& result);
+    PartialResult WARN_UNUSED_RETURN addSIMDBitSelect(ExpressionType left, ExpressionType right, ExpressionType mask, ExpressionType& result);
+
+    // Atomics
+    PartialResult WARN_UNUSED_RETURN addAtomicLoad(AtomicOpType, ExpressionType pointer, uint32_t offset, ExpressionType& result);
+    PartialResult WARN_UNUSED_RETURN addAtomicStore(AtomicOpType, ExpressionType pointer, ExpressionType value, uint32_t offset);
+    PartialResult WARN_UNUSED_RETURN addAtomicBinaryRMW(AtomicOpType, ExpressionType pointer, ExpressionType value, uint32_t offset, ExpressionType& result);
+    PartialResult WARN_UNUSED_RETURN addAtomicCompareExchange(AtomicOpType, ExpressionType pointer, ExpressionType expected, ExpressionType replacement, uint32_t offset, ExpressionType& result);
+    PartialResult WARN_UNUSED_RETURN addAtomicWait(AtomicOpType, ExpressionType pointer, ExpressionType expected, ExpressionType timeout, uint32_t offset, ExpressionType& result);
+    PartialResult WARN_UNUSED_RETURN addAtomicNotify(ExpressionType pointer, ExpressionType count, uint32_t offset, ExpressionType& result);
+    PartialResult WARN_UNUSED_RETURN addAtomicFence();
+
     // Control flow
     ControlData WARN_UNUSED_RETURN addTopLevel(Type signature);
     ControlData WARN_UNUSED_RETURN addBlock(Type signature);
@@ -229,16 +259,34 @@ public:
     Value* constant(B3::Type, uint64_t bits, std::optional<Origin> = std::nullopt);
     void insertConstants();
 
+    bool didEmitOSREntry() const { return m_didEmitOSREntry; }
+
 private:
     void emitExceptionCheck(CCallHelpers&, ExceptionType);
 
     void emitTierUpCheck(uint32_t decrementCount, Origin);
+    void emitLoopTierUpCheck(uint32_t loopIndex, Origin);
+    bool canOSREnterLoop() const;
 
     ExpressionType emitCheckAndPreparePointer(ExpressionType pointer, uint32_t offset, uint32_t sizeOfOp);
+    using BulkMemoryOperation = int32_t (*)(Instance*, uint32_t, uint32_t, uint32_t);
+    void emitBulkMemoryOperation(BulkMemoryOperation, ExpressionType destination, ExpressionType sourceOrValue, ExpressionType count);
     B3::Kind memoryKind(B3::Opcode memoryOp);
     ExpressionType emitLoadOp(LoadOpType, ExpressionType pointer, uint32_t offset);
     void emitStoreOp(StoreOpType, ExpressionType pointer, ExpressionType value, uint32_t offset);
 
+    enum class LaneExtension { Sign, Zero };
+    Value* addV128Slot(std::optional<Origin> = std::nullopt);
+    void copyV128(Value* destination, Value* source);
+    Value* loadLane(Value* vector, SIMDLane, unsigned index, LaneExtension = LaneExtension::Sign);
+    void storeLane(Value* vector, SIMDLane, unsigned index, Value*);
+    Value* laneMask(SIMDLane, Value* condition);
+    Value* truncateFloatToInt32Saturated(Value*, bool isSigned);
+
+    Value* emitAtomicAddress(AtomicOpType, ExpressionType pointer, uint32_t offset);
+    Value* truncateAtomicOperand(AtomicOpType, Value*);
+    Value* zeroExtendAtomicResult(AtomicOpType, Value*);
+
     void unify(const ExpressionType phi, const ExpressionType source);
     void unifyValuesWithBlock(const ExpressionList& resultStack, const ResultList& stack);
 
@@ -257,11 +305,19 @@ private:
     const MemoryMode m_mode { MemoryMode::BoundsChecking };
     const CompilationMode m_compilationMode { CompilationMode::BBQMode };
     const unsigned m_functionIndex { UINT_MAX };
-    const TierUpCount* m_tierUp { nullptr };
+    TierUpCount* m_tierUp { nullptr };
+    uint64_t* m_callCount { nullptr };
+    const uint32_t m_loopIndexForOSREntry { UINT32_MAX };
+    uint32_t m_loopCount { 0 };
+    bool m_didEmitOSREntry { false };
 
     Procedure& m_proc;
     BasicBlock* m_currentBlock { nullptr };
+    BasicBlock* m_rootBlock { nullptr }; // Only set when compiling for OSR entry.
+    Value* m_osrEntryScratchBuffer { nullptr };
     Vector<Variable*> m_locals;
+    Vector<Type> m_localTypes;
+    bool m_hasV128Locals { false };
     Vector<UnlinkedWasmToWasmCall>& m_unlinkedWasmToWasmCalls; // List each call site and the function index whose address it should be patched with.
     HashMap<ValueKey, Value*> m_constantPool;
     InsertionSet m_constantInsertionValues;
@@ -321,12 +377,14 @@ void B3IRGenerator::restoreWasmContextInstance(Procedure& proc, BasicBlock* bloc
     });
 }
 
-B3IRGenerator::B3IRGenerator(const ModuleInformation& info, Procedure& procedure, InternalFunction* compilation, Vector<UnlinkedWasmToWasmCall>& unlinkedWasmToWasmCalls, MemoryMode mode, CompilationMode compilationMode, unsigned functionIndex, TierUpCount* tierUp, ThrowWasmException throwWasmException)
+B3IRGenerator::B3IRGenerator(const ModuleInformation& info, Procedure& procedure, InternalFunction* compilation, Vector<UnlinkedWasmToWasmCall>& unlinkedWasmToWasmCalls, MemoryMode mode, CompilationMode compilationMode, unsigned functionIndex, TierUpCount* tierUp, ThrowWasmException throwWasmException, uint64_t* callCount, uint32_t loopIndexForOSREntry)
     : m_info(info)
     , m_mode(mode)
     , m_compilationMode(compilationMode)
     , m_functionIndex(functionIndex)
     , m_tierUp(tierUp)
+    , m_callCount(callCount)
+    , m_loopIndexForOSREntry(loopIndexForOSREntry)
     , m_proc(procedure)
     , m_unlinkedWasmToWasmCalls(unlinkedWasmToWasmCalls)
     , m_constantInsertionValues(m_proc)
@@ -450,6 +508,23 @@ B3IRGenerator::B3IRGenerator(const ModuleInformation& info, Procedure& procedure
     }
 
     emitTierUpCheck(TierUpCount::functionEntryDecrement(), Origin());
+
+    if (m_callCount) {
+        Value* callCountLocation = constant(pointerType(), reinterpret_cast<uint64_t>(m_callCount), Origin());
+        Value* oldCallCount = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int64, Origin(), callCountLocation);
+        Value* newCallCount = m_currentBlock->appendNew<Value>(m_proc, Add, Origin(), oldCallCount, constant(Int64, 1, Origin()));
+        m_currentBlock->appendNew<MemoryValue>(m_proc, Store, Origin(), newCallCount, callCountLocation);
+    }
+
+    if (m_compilationMode == CompilationMode::OMGForOSREntryMode) {
+        // OSR entry code is jumped to from a BBQ loop tier-up check, with a buffer holding the
+        // function's locals in the first argument register. When parsing reaches that loop, the
+        // root block reloads the locals and jumps there, so the function's own entry is unreachable.
+        ASSERT(m_loopIndexForOSREntry != UINT32_MAX);
+        m_rootBlock = m_currentBlock;
+        m_osrEntryScratchBuffer = m_rootBlock->appendNew<ArgumentRegValue>(m_proc, Origin(), GPRInfo::argumentGPR0);
+        m_currentBlock = m_proc.addBlock();
+    }
 }
 
 void B3IRGenerator::restoreWebAssemblyGlobalState(RestoreCachedStackLimit restoreCachedStackLimit, const MemoryInformation& memory, Value* instance, Procedure& proc, BasicBlock* block)
@@ -522,11 +597,21 @@ auto B3IRGenerator::addLocal(Type type, uint32_t count) -> PartialResult
     Checked<uint32_t, RecordOverflow> totalBytesChecked = count;
     totalBytesChecked += m_locals.size();
     uint32_t totalBytes;
-    WASM_COMPILE_FAIL_IF((totalBytesChecked.safeGet(totalBytes) == CheckedState::DidOverflow) || !m_locals.tryReserveCapacity(totalBytes), "can't allocate memory for ", totalBytes, " locals");
+    WASM_COMPILE_FAIL_IF((totalBytesChecked.safeGet(totalBytes) == CheckedState::DidOverflow) || !m_locals.tryReserveCapacity(totalBytes) || !m_localTypes.tryReserveCapacity(totalBytes), "can't allocate memory for ", totalBytes, " locals");
 
     for (uint32_t i = 0; i < count; ++i) {
         Variable* local = m_proc.addVariable(toB3Type(type));
         m_locals.uncheckedAppend(local);
+        m_localTypes.uncheckedAppend(type);
+        if (type == V128) {
+            // A v128 local owns a stack slot, and its variable always points to that slot.
+            Value* slot = addV128Slot(Origin());
+            for (int32_t offset = 0; offset < v128Bytes; offset += v128HalfBytes)
+                m_currentBlock->appendNew<MemoryValue>(m_proc, Store, Origin(), constant(Int64, 0, Origin()), slot, offset);
+            m_currentBlock->appendNew<VariableValue>(m_proc, Set, Origin(), local, slot);
+            m_hasV128Locals = true;
+            continue;
+        }
         m_currentBlock->appendNew<VariableValue>(m_proc, Set, Origin(), local, constant(toB3Type(type), 0, Origin()));
     }
     return { };
@@ -538,6 +623,9 @@ auto B3IRGenerator::addArguments(const Signature& signature) -> PartialResult
     WASM_COMPILE_FAIL_IF(!m_locals.tryReserveCapacity(signature.argumentCount()), "can't allocate memory for ", signature.argumentCount(), " arguments");
 
     m_locals.grow(signature.argumentCount());
+    m_localTypes.grow(signature.argumentCount());
+    for (size_t i = 0; i < signature.argumentCount(); ++i)
+        m_localTypes[i] = signature.argument(i);
     wasmCallingConvention().loadArguments(signature, m_proc, m_currentBlock, Origin(),
         [=] (ExpressionType argument, unsigned i) {
             Variable* argumentVariable = m_proc.addVariable(argument->type());
@@ -551,6 +639,12 @@ auto B3IRGenerator::getLocal(uint32_t index, ExpressionType& result) -> PartialR
 {
     ASSERT(m_locals[index]);
     result = m_currentBlock->appendNew<VariableValue>(m_proc, B3::Get, origin(), m_locals[index]);
+    if (m_localTypes[index] == V128) {
+        // Copy, so that a later set_local doesn't change the value we return.
+        Value* slot = result;
+        result = addV128Slot();
+        copyV128(result, slot);
+    }
     return { };
 }
 
@@ -611,9 +705,59 @@ auto B3IRGenerator::addCurrentMemory(ExpressionType& result) -> PartialResult
     return { };
 }
 
+// Bulk memory operations call out to memmove / memset, which are already vectorized. They check
+// bounds themselves because a fast memory's PROT_NONE pages only protect JIT code, and report
+// failure so the trap is thrown from JIT code.
+static bool memoryRangeIsInBounds(Instance* instance, uint32_t offset, uint32_t count)
+{
+    return static_cast<uint64_t>(offset) + count <= instance->cachedMemorySize();
+}
+
+void B3IRGenerator::emitBulkMemoryOperation(BulkMemoryOperation operation, ExpressionType destination, ExpressionType sourceOrValue, ExpressionType count)
+{
+    Value* inBounds = m_currentBlock->appendNew<CCallValue>(m_proc, Int32, origin(),
+        m_currentBlock->appendNew<ConstPtrValue>(m_proc, origin(), tagCFunctionPtr<void*>(operation, B3CCallPtrTag)),
+        instanceValue(), destination, sourceOrValue, count);
+
+    CheckValue* check = m_currentBlock->appendNew<CheckValue>(m_proc, Check, origin(),
+        m_currentBlock->appendNew<Value>(m_proc, Equal, origin(), inBounds, m_currentBlock->appendNew<Const32Value>(m_proc, origin(), 0)));
+    check->setGenerator([=] (CCallHelpers& jit, const B3::StackmapGenerationParams&) {
+        this->emitExceptionCheck(jit, ExceptionType::OutOfBoundsMemoryAccess);
+    });
+}
+
+auto B3IRGenerator::addMemoryCopy(ExpressionType destination, ExpressionType source, ExpressionType count) -> PartialResult
+{
+    BulkMemoryOperation memoryCopy = [] (Instance* instance, uint32_t destination, uint32_t source, uint32_t count) -> int32_t {
+        if (!memoryRangeIsInBounds(instance, destination, count) || !memoryRangeIsInBounds(instance, source, count))
+            return false;
+        uint8_t* memory = static_cast<uint8_t*>(instance->cachedMemory());
+        memmove(memory + destination, memory + source, count);
+        return true;
+    };
+    emitBulkMemoryOperation(memoryCopy, destination, source, count);
+    return { };
+}
+
+auto B3IRGenerator::addMemoryFill(ExpressionType destination, ExpressionType value, ExpressionType count) -> PartialResult
+{
+    BulkMemoryOperation memoryFill = [] (Instance* instance, uint32_t destination, uint32_t value, uint32_t count) -> int32_t {
+        if (!memoryRangeIsInBounds(instance, destination, count))
+            return false;
+        memset(static_cast<uint8_t*>(instance->cachedMemory()) + destination, static_cast<uint8_t>(value), count);
+        return true;
+    };
+    emitBulkMemoryOperation(memoryFill, destination, value, count);
+    return { };
+}
+
 auto B3IRGenerator::setLocal(uint32_t index, ExpressionType value) -> PartialResult
 {
     ASSERT(m_locals[index]);
+    if (m_localTypes[index] == V128) {
+        copyV128(m_currentBlock->appendNew<VariableValue>(m_proc, B3::Get, origin(), m_locals[index]), value);
+        return { };
+    }
     m_currentBlock->appendNew<VariableValue>(m_proc, B3::Set, origin(), m_locals[index], value);
     return { };
 }
@@ -898,6 +1042,885 @@ B3IRGenerator::ExpressionType B3IRGenerator::addConstant(Type type, uint64_t val
     return constant(toB3Type(type), value);
 }
 
+// v128 values are pointers to 16-byte stack slots. Every instruction that produces a v128 writes a
+// slot of its own, so a value never changes after it is produced. Lanes are loaded and stored with
+// scalar B3 operations.
+Value* B3IRGenerator::addV128Slot(std::optional<Origin> maybeOrigin)
+{
+    return m_currentBlock->appendNew<SlotBaseValue>(m_proc, maybeOrigin ? *maybeOrigin : origin(), m_proc.addStackSlot(sizeof(v128_t)));
+}
+
+void B3IRGenerator::copyV128(Value* destination, Value* source)
+{
+    for (int32_t offset = 0; offset < v128Bytes; offset += v128HalfBytes) {
+        Value* half = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int64, origin(), source, offset);
+        m_currentBlock->appendNew<MemoryValue>(m_proc, Store, origin(), half, destination, offset);
+    }
+}
+
+Value* B3IRGenerator::loadLane(Value* vector, SIMDLane lane, unsigned index, LaneExtension extension)
+{
+    int32_t offset = index * laneSizeInBytes(lane);
+    switch (lane) {
+    case SIMDLane::I8x16:
+        return m_currentBlock->appendNew<MemoryValue>(m_proc, extension == LaneExtension::Sign ? Load8S : Load8Z, origin(), vector, offset);
+    case SIMDLane::I16x8:
+        return m_currentBlock->appendNew<MemoryValue>(m_proc, extension == LaneExtension::Sign ? Load16S : Load16Z, origin(), vector, offset);
+    case SIMDLane::I32x4:
+        return m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int32, origin(), vector, offset);
+    case SIMDLane::I64x2:
+        return m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int64, origin(), vector, offset);
+    case SIMDLane::F32x4:
+        return m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Float, origin(), vector, offset);
+    case SIMDLane::F64x2:
+        return m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Double, origin(), vector, offset);
+    case SIMDLane::V128:
+        break;
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return nullptr;
+}
+
+void B3IRGenerator::storeLane(Value* vector, SIMDLane lane, unsigned index, Value* value)
+{
+    int32_t offset = index * laneSizeInBytes(lane);
+    switch (lane) {
+    case SIMDLane::I8x16:
+        m_currentBlock->appendNew<MemoryValue>(m_proc, Store8, origin(), value, vector, offset);
+        return;
+    case SIMDLane::I16x8:
+        m_currentBlock->appendNew<MemoryValue>(m_proc, Store16, origin(), value, vector, offset);
+        return;
+    case SIMDLane::I32x4:
+    case SIMDLane::I64x2:
+    case SIMDLane::F32x4:
+    case SIMDLane::F64x2:
+        m_currentBlock->appendNew<MemoryValue>(m_proc, Store, origin(), value, vector, offset);
+        return;
+    case SIMDLane::V128:
+        break;
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+}
+
+// Comparisons produce a lane of all ones or all zeros, as an integer as wide as the lane.
+Value* B3IRGenerator::laneMask(SIMDLane lane, Value* condition)
+{
+    if (lane == SIMDLane::I64x2 || lane == SIMDLane::F64x2)
+        condition = m_currentBlock->appendNew<Value>(m_proc, ZExt32, origin(), condition);
+    return m_currentBlock->appendNew<Value>(m_proc, Neg, origin(), condition);
+}
+
+// NaN becomes 0, and out of range values become the nearest representable integer.
+Value* B3IRGenerator::truncateFloatToInt32Saturated(Value* value, bool isSigned)
+{
+    float maxBound = isSigned ? -static_cast<float>(std::numeric_limits<int32_t>::min()) : static_cast<float>(std::numeric_limits<int32_t>::min()) * -2.0f;
+    float minBound = isSigned ? static_cast<float>(std::numeric_limits<int32_t>::min()) : -1.0f;
+    Value* zero = constant(Float, bitwise_cast<uint32_t>(0.0f));
+    Value* inRange = m_currentBlock->appendNew<Value>(m_proc, BitAnd, origin(),
+        m_currentBlock->appendNew<Value>(m_proc, LessThan, origin(), value, constant(Float, bitwise_cast<uint32_t>(maxBound))),
+        m_currentBlock->appendNew<Value>(m_proc, isSigned ? GreaterEqual : GreaterThan, origin(), value, constant(Float, bitwise_cast<uint32_t>(minBound))));
+
+    PatchpointValue* truncate = m_currentBlock->appendNew<PatchpointValue>(m_proc, Int32, origin());
+    truncate->append(m_currentBlock->appendNew<Value>(m_proc, B3::Select, origin(), inRange, value, zero), ValueRep::SomeRegister);
+    truncate->setGenerator([=] (CCallHelpers& jit, const StackmapGenerationParams& params) {
+        if (isSigned)
+            jit.truncateFloatToInt32(params[1].fpr(), params[0].gpr());
+        else
+            jit.truncateFloatToUint32(params[1].fpr(), params[0].gpr());
+    });
+    truncate->effects = Effects::none();
+
+    Value* maxValue = constant(Int32, isSigned ? std::numeric_limits<int32_t>::max() : std::numeric_limits<uint32_t>::max());
+    Value* minValue = constant(Int32, isSigned ? std::numeric_limits<int32_t>::min() : 0);
+    Value* outOfRange = m_currentBlock->appendNew<Value>(m_proc, B3::Select, origin(),
+        m_currentBlock->appendNew<Value>(m_proc, GreaterThan, origin(), value, zero), maxValue,
+        m_currentBlock->appendNew<Value>(m_proc, B3::Select, origin(),
+            m_currentBlock->appendNew<Value>(m_proc, LessThan, origin(), value, zero), minValue, constant(Int32, 0)));
+    return m_currentBlock->appendNew<Value>(m_proc, B3::Select, origin(), inRange, truncate, outOfRange);
+}
+
+auto B3IRGenerator::addSIMDLoad(ExpressionType pointer, uint32_t offset, ExpressionType& result) -> PartialResult
+{
+    ASSERT(pointer->type() == Int32);
+    result = addV128Slot();
+
+    if (UNLIKELY(sumOverflows<uint32_t>(offset, v128Bytes))) {
+        B3::PatchpointValue* throwException = m_currentBlock->appendNew<B3::PatchpointValue>(m_proc, B3::Void, origin());
+        throwException->setGenerator([this] (CCallHelpers& jit, const B3::StackmapGenerationParams&) {
+            this->emitExceptionCheck(jit, ExceptionType::OutOfBoundsMemoryAccess);
+        });
+        return { };
+    }
+
+    Value* address = emitCheckAndPreparePointer(pointer, offset, v128Bytes);
+    for (int32_t i = 0; i < 2; ++i) {
+        Value* halfAddress = address;
+        int32_t halfOffset = fixupPointerPlusOffset(halfAddress, offset + i * v128HalfBytes);
+        Value* half = m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load), Int64, origin(), halfAddress, halfOffset);
+        m_currentBlock->appendNew<MemoryValue>(m_proc, Store, origin(), half, result, i * v128HalfBytes);
+    }
+    return { };
+}
+
+auto B3IRGenerator::addSIMDStore(ExpressionType pointer, ExpressionType value, uint32_t offset) -> PartialResult
+{
+    ASSERT(pointer->type() == Int32);
+
+    if (UNLIKELY(sumOverflows<uint32_t>(offset, v128Bytes))) {
+        B3::PatchpointValue* throwException = m_currentBlock->appendNew<B3::PatchpointValue>(m_proc, B3::Void, origin());
+        throwException->setGenerator([this] (CCallHelpers& jit, const B3::StackmapGenerationParams&) {
+            this->emitExceptionCheck(jit, ExceptionType::OutOfBoundsMemoryAccess);
+        });
+        return { };
+    }
+
+    Value* address = emitCheckAndPreparePointer(pointer, offset, v128Bytes);
+    for (int32_t i = 0; i < 2; ++i) {
+        Value* half = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int64, origin(), value, i * v128HalfBytes);
+        Value* halfAddress = address;
+        int32_t halfOffset = fixupPointerPlusOffset(halfAddress, offset + i * v128HalfBytes);
+        m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Store), origin(), half, halfAddress, halfOffset);
+    }
+    return { };
+}
+
+B3IRGenerator::ExpressionType B3IRGenerator::addSIMDConstant(const v128_t& value)
+{
+    Value* result = addV128Slot();
+    for (int32_t i = 0; i < 2; ++i)
+        m_currentBlock->appendNew<MemoryValue>(m_proc, Store, origin(), constant(Int64, value.u64x2[i]), result, i * v128HalfBytes);
+    return result;
+}
+
+auto B3IRGenerator::addSIMDShuffle(const v128_t& laneIndices, ExpressionType left, ExpressionType right, ExpressionType& result) -> PartialResult
+{
+    result = addV128Slot();
+    for (unsigned i = 0; i < 16; ++i) {
+        uint8_t laneIndex = laneIndices.u8x16[i];
+        Value* lane = loadLane(laneIndex < 16 ? left : right, SIMDLane::I8x16, laneIndex % 16, LaneExtension::Zero);
+        storeLane(result, SIMDLane::I8x16, i, lane);
+    }
+    return { };
+}
+
+auto B3IRGenerator::addSIMDExtractLane(SIMDOpType op, uint8_t laneIndex, ExpressionType vector, ExpressionType& result) -> PartialResult
+{
+    bool zeroExtend = op == SIMDOpType::I8x16ExtractLaneU || op == SIMDOpType::I16x8ExtractLaneU;
+    result = loadLane(vector, simdLane(op), laneIndex, zeroExtend ? LaneExtension::Zero : LaneExtension::Sign);
+    return { };
+}
+
+auto B3IRGenerator::addSIMDReplaceLane(SIMDOpType op, uint8_t laneIndex, ExpressionType vector, ExpressionType scalar, ExpressionType& result) -> PartialResult
+{
+    result = addV128Slot();
+    copyV128(result, vector);
+    storeLane(result, simdLane(op), laneIndex, scalar);
+    return { };
+}
+
+auto B3IRGenerator::addSIMDUnary(SIMDOpType op, ExpressionType value, ExpressionType& result) -> PartialResult
+{
+    SIMDLane lane = simdLane(op);
+
+    switch (op) {
+    case SIMDOpType::V128AnyTrue: {
+        Value* low = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int64, origin(), value, 0);
+        Value* high = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int64, origin(), value, v128HalfBytes);
+        result = m_currentBlock->appendNew<Value>(m_proc, NotEqual, origin(),
+            m_currentBlock->appendNew<Value>(m_proc, BitOr, origin(), low, high), constant(Int64, 0));
+        return { };
+    }
+
+    case SIMDOpType::I8x16AllTrue:
+    case SIMDOpType::I16x8AllTrue:
+    case SIMDOpType::I32x4AllTrue:
+    case SIMDOpType::I64x2AllTrue: {
+        Value* zero = constant(lane == SIMDLane::I64x2 ? Int64 : Int32, 0);
+        result = constant(Int32, 1);
+        for (unsigned i = 0; i < laneCount(lane); ++i) {
+            Value* isNonZero = m_currentBlock->appendNew<Value>(m_proc, NotEqual, origin(), loadLane(value, lane, i), zero);
+            result = m_currentBlock->appendNew<Value>(m_proc, BitAnd, origin(), result, isNonZero);
+        }
+        return { };
+    }
+
+    case SIMDOpType::I8x16Bitmask:
+    case SIMDOpType::I16x8Bitmask:
+    case SIMDOpType::I32x4Bitmask:
+    case SIMDOpType::I64x2Bitmask: {
+        Value* zero = constant(lane == SIMDLane::I64x2 ? Int64 : Int32, 0);
+        result = constant(Int32, 0);
+        for (unsigned i = 0; i < laneCount(lane); ++i) {
+            Value* isNegative = m_currentBlock->appendNew<Value>(m_proc, LessThan, origin(), loadLane(value, lane, i), zero);
+            result = m_currentBlock->appendNew<Value>(m_proc, BitOr, origin(), result,
+                m_currentBlock->appendNew<Value>(m_proc, Shl, origin(), isNegative, constant(Int32, i)));
+        }
+        return { };
+    }
+
+    default:
+        break;
+    }
+
+    result = addV128Slot();
+
+    if (op == SIMDOpType::V128Not) {
+        for (int32_t offset = 0; offset < v128Bytes; offset += v128HalfBytes) {
+            Value* half = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int64, origin(), value, offset);
+            half = m_currentBlock->appendNew<Value>(m_proc, BitXor, origin(), half, constant(Int64, -1));
+            m_currentBlock->appendNew<MemoryValue>(m_proc, Store, origin(), half, result, offset);
+        }
+        return { };
+    }
+
+    for (unsigned i = 0; i < laneCount(lane); ++i) {
+        if (simdCategory(op) == SIMDOpCategory::Splat) {
+            storeLane(result, lane, i, value);
+            continue;
+        }
+
+        Value* laneValue;
+        switch (op) {
+        case SIMDOpType::I8x16Abs:
+        case SIMDOpType::I16x8Abs:
+        case SIMDOpType::I32x4Abs:
+        case SIMDOpType::I64x2Abs: {
+            Value* operand = loadLane(value, lane, i);
+            Value* isNegative = m_currentBlock->appendNew<Value>(m_proc, LessThan, origin(), operand, constant(operand->type(), 0));
+            laneValue = m_currentBlock->appendNew<Value>(m_proc, B3::Select, origin(), isNegative,
+                m_currentBlock->appendNew<Value>(m_proc, Neg, origin(), operand), operand);
+            break;
+        }
+        case SIMDOpType::I8x16Neg:
+        case SIMDOpType::I16x8Neg:
+        case SIMDOpType::I32x4Neg:
+        case SIMDOpType::I64x2Neg:
+        case SIMDOpType::F32x4Neg:
+        case SIMDOpType::F64x2Neg:
+            laneValue = m_currentBlock->appendNew<Value>(m_proc, Neg, origin(), loadLane(value, lane, i));
+            break;
+        case SIMDOpType::F32x4Abs:
+        case SIMDOpType::F64x2Abs:
+            laneValue = m_currentBlock->appendNew<Value>(m_proc, Abs, origin(), loadLane(value, lane, i));
+            break;
+        case SIMDOpType::F32x4Sqrt:
+        case SIMDOpType::F64x2Sqrt:
+            laneValue = m_currentBlock->appendNew<Value>(m_proc, Sqrt, origin(), loadLane(value, lane, i));
+            break;
+        case SIMDOpType::I32x4TruncSatF32x4S:
+        case SIMDOpType::I32x4TruncSatF32x4U:
+            laneValue = truncateFloatToInt32Saturated(loadLane(value, SIMDLane::F32x4, i), op == SIMDOpType::I32x4TruncSatF32x4S);
+            break;
+        case SIMDOpType::F32x4ConvertI32x4S:
+            laneValue = m_currentBlock->appendNew<Value>(m_proc, IToF, origin(), loadLane(value, SIMDLane::I32x4, i));
+            break;
+        case SIMDOpType::F32x4ConvertI32x4U:
+            laneValue = m_currentBlock->appendNew<Value>(m_proc, IToF, origin(),
+                m_currentBlock->appendNew<Value>(m_proc, ZExt32, origin(), loadLane(value, SIMDLane::I32x4, i)));
+            break;
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+        storeLane(result, lane, i, laneValue);
+    }
+    return { };
+}
+
+auto B3IRGenerator::addSIMDBinary(SIMDOpType op, ExpressionType left, ExpressionType right, ExpressionType& result) -> PartialResult
+{
+    SIMDLane lane = simdLane(op);
+    result = addV128Slot();
+
+    if (lane == SIMDLane::V128) {
+        for (int32_t offset = 0; offset < v128Bytes; offset += v128HalfBytes) {
+            Value* leftHalf = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int64, origin(), left, offset);
+            Value* rightHalf = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int64, origin(), right, offset);
+            Value* half;
+            switch (op) {
+            case SIMDOpType::V128And:
+                half = m_currentBlock->appendNew<Value>(m_proc, BitAnd, origin(), leftHalf, rightHalf);
+                break;
+            case SIMDOpType::V128AndNot:
+                half = m_currentBlock->appendNew<Value>(m_proc, BitAnd, origin(), leftHalf,
+                    m_currentBlock->appendNew<Value>(m_proc, BitXor, origin(), rightHalf, constant(Int64, -1)));
+                break;
+            case SIMDOpType::V128Or:
+                half = m_currentBlock->appendNew<Value>(m_proc, BitOr, origin(), leftHalf, rightHalf);
+                break;
+            case SIMDOpType::V128Xor:
+                half = m_currentBlock->appendNew<Value>(m_proc, BitXor, origin(), leftHalf, rightHalf);
+                break;
+            default:
+                RELEASE_ASSERT_NOT_REACHED();
+            }
+            m_currentBlock->appendNew<MemoryValue>(m_proc, Store, origin(), half, result, offset);
+        }
+        return { };
+    }
+
+    if (simdCategory(op) == SIMDOpCategory::Shift) {
+        // The shift count is taken modulo the lane width.
+        Value* count = m_currentBlock->appendNew<Value>(m_proc, BitAnd, origin(), right, constant(Int32, laneSizeInBytes(lane) * 8 - 1));
+        for (unsigned i = 0; i < laneCount(lane); ++i) {
+            B3::Opcode shift;
+            LaneExtension extension = LaneExtension::Sign;
+            switch (op) {
+            case SIMDOpType::I8x16Shl:
+            case SIMDOpType::I16x8Shl:
+            case SIMDOpType::I32x4Shl:
+            case SIMDOpType::I64x2Shl:
+                shift = Shl;
+                break;
+            case SIMDOpType::I8x16ShrS:
+            case SIMDOpType::I16x8ShrS:
+            case SIMDOpType::I32x4ShrS:
+            case SIMDOpType::I64x2ShrS:
+                shift = SShr;
+                break;
+            case SIMDOpType::I8x16ShrU:
+            case SIMDOpType::I16x8ShrU:
+            case SIMDOpType::I32x4ShrU:
+            case SIMDOpType::I64x2ShrU:
+                shift = ZShr;
+                extension = LaneExtension::Zero;
+                break;
+            default:
+                RELEASE_ASSERT_NOT_REACHED();
+            }
+            storeLane(result, lane, i, m_currentBlock->appendNew<Value>(m_proc, shift, origin(), loadLane(left, lane, i, extension), count));
+        }
+        return { };
+    }
+
+    if (op == SIMDOpType::I8x16Swizzle) {
+        // Lane indices of 16 or more select zero.
+        for (unsigned i = 0; i < 16; ++i) {
+            Value* laneIndex = loadLane(right, SIMDLane::I8x16, i, LaneExtension::Zero);
+            Value* address = m_currentBlock->appendNew<Value>(m_proc, Add, origin(), left,
+                m_currentBlock->appendNew<Value>(m_proc, ZExt32, origin(),
+                    m_currentBlock->appendNew<Value>(m_proc, BitAnd, origin(), laneIndex, constant(Int32, 15))));
+            Value* selected = m_currentBlock->appendNew<MemoryValue>(m_proc, Load8Z, origin(), address);
+            Value* inRange = m_currentBlock->appendNew<Value>(m_proc, Below, origin(), laneIndex, constant(Int32, 16));
+            storeLane(result, SIMDLane::I8x16, i, m_currentBlock->appendNew<Value>(m_proc, B3::Select, origin(), inRange, selected, constant(Int32, 0)));
+        }
+        return { };
+    }
+
+    // Saturating and rounding arithmetic is done on 32-bit values, which can't overflow for 8 and
+    // 16 bit lanes.
+    int32_t signedMin = lane == SIMDLane::I8x16 ? std::numeric_limits<int8_t>::min() : std::numeric_limits<int16_t>::min();
+    int32_t signedMax = lane == SIMDLane::I8x16 ? std::numeric_limits<int8_t>::max() : std::numeric_limits<int16_t>::max();
+    int32_t unsignedMax = lane == SIMDLane::I8x16 ? std::numeric_limits<uint8_t>::max() : std::numeric_limits<uint16_t>::max();
+    auto clamp = [&] (Value* value, std::optional<int32_t> min, std::optional<int32_t> max) {
+        if (max) {
+            Value* bound = constant(Int32, *max);
+            value = m_currentBlock->appendNew<Value>(m_proc, B3::Select, origin(),
+                m_currentBlock->appendNew<Value>(m_proc, GreaterThan, origin(), value, bound), bound, value);
+        }
+        if (min) {
+            Value* bound = constant(Int32, *min);
+            value = m_currentBlock->appendNew<Value>(m_proc, B3::Select, origin(),
+                m_currentBlock->appendNew<Value>(m_proc, LessThan, origin(), value, bound), bound, value);
+        }
+        return value;
+    };
+
+    for (unsigned i = 0; i < laneCount(lane); ++i) {
+        LaneExtension extension = LaneExtension::Sign;
+        switch (op) {
+        case SIMDOpType::I8x16LtU:
+        case SIMDOpType::I8x16GtU:
+        case SIMDOpType::I8x16LeU:
+        case SIMDOpType::I8x16GeU:
+        case SIMDOpType::I8x16AddSatU:
+        case SIMDOpType::I8x16SubSatU:
+        case SIMDOpType::I8x16MinU:
+        case SIMDOpType::I8x16MaxU:
+        case SIMDOpType::I8x16AvgrU:
+        case SIMDOpType::I16x8LtU:
+        case SIMDOpType::I16x8GtU:
+        case SIMDOpType::I16x8LeU:
+        case SIMDOpType::I16x8GeU:
+        case SIMDOpType::I16x8AddSatU:
+        case SIMDOpType::I16x8SubSatU:
+        case SIMDOpType::I16x8MinU:
+        case SIMDOpType::I16x8MaxU:
+        case SIMDOpType::I16x8AvgrU:
+            extension = LaneExtension::Zero;
+            break;
+        default:
+            break;
+        }
+        Value* a = loadLane(left, lane, i, extension);
+        Value* b = loadLane(right, lane, i, extension);
+        auto compare = [&] (B3::Opcode comparison) {
+            return laneMask(lane, m_currentBlock->appendNew<Value>(m_proc, comparison, origin(), a, b));
+        };
+        auto select = [&] (B3::Opcode comparison, Value* ifTrue, Value* ifFalse) {
+            return m_currentBlock->appendNew<Value>(m_proc, B3::Select, origin(),
+                m_currentBlock->appendNew<Value>(m_proc, comparison, origin(), a, b), ifTrue, ifFalse);
+        };
+
+        Value* laneValue;
+        switch (op) {
+        case SIMDOpType::I8x16Eq:
+        case SIMDOpType::I16x8Eq:
+        case SIMDOpType::I32x4Eq:
+        case SIMDOpType::I64x2Eq:
+        case SIMDOpType::F32x4Eq:
+        case SIMDOpType::F64x2Eq:
+            laneValue = compare(Equal);
+            break;
+        case SIMDOpType::I8x16Ne:
+        case SIMDOpType::I16x8Ne:
+        case SIMDOpType::I32x4Ne:
+        case SIMDOpType::I64x2Ne:
+        case SIMDOpType::F32x4Ne:
+        case SIMDOpType::F64x2Ne:
+            laneValue = compare(NotEqual);
+            break;
+        case SIMDOpType::I8x16LtS:
+        case SIMDOpType::I16x8LtS:
+        case SIMDOpType::I32x4LtS:
+        case SIMDOpType::I64x2LtS:
+        case SIMDOpType::F32x4Lt:
+        case SIMDOpType::F64x2Lt:
+            laneValue = compare(LessThan);
+            break;
+        case SIMDOpType::I8x16GtS:
+        case SIMDOpType::I16x8GtS:
+        case SIMDOpType::I32x4GtS:
+        case SIMDOpType::I64x2GtS:
+        case SIMDOpType::F32x4Gt:
+        case SIMDOpType::F64x2Gt:
+            laneValue = compare(GreaterThan);
+            break;
+        case SIMDOpType::I8x16LeS:
+        case SIMDOpType::I16x8LeS:
+        case SIMDOpType::I32x4LeS:
+        case SIMDOpType::I64x2LeS:
+        case SIMDOpType::F32x4Le:
+        case SIMDOpType::F64x2Le:
+            laneValue = compare(LessEqual);
+            break;
+        case SIMDOpType::I8x16GeS:
+        case SIMDOpType::I16x8GeS:
+        case SIMDOpType::I32x4GeS:
+        case SIMDOpType::I64x2GeS:
+        case SIMDOpType::F32x4Ge:
+        case SIMDOpType::F64x2Ge:
+            laneValue = compare(GreaterEqual);
+            break;
+        // Narrow lanes are zero extended for unsigned comparisons, so a signed comparison works.
+        case SIMDOpType::I8x16LtU:
+        case SIMDOpType::I16x8LtU:
+            laneValue = compare(LessThan);
+            break;
+        case SIMDOpType::I32x4LtU:
+            laneValue = compare(Below);
+            break;
+        case SIMDOpType::I8x16GtU:
+        case SIMDOpType::I16x8GtU:
+            laneValue = compare(GreaterThan);
+            break;
+        case SIMDOpType::I32x4GtU:
+            laneValue = compare(Above);
+            break;
+        case SIMDOpType::I8x16LeU:
+        case SIMDOpType::I16x8LeU:
+            laneValue = compare(LessEqual);
+            break;
+        case SIMDOpType::I32x4LeU:
+            laneValue = compare(BelowEqual);
+            break;
+        case SIMDOpType::I8x16GeU:
+        case SIMDOpType::I16x8GeU:
+            laneValue = compare(GreaterEqual);
+            break;
+        case SIMDOpType::I32x4GeU:
+            laneValue = compare(AboveEqual);
+            break;
+        case SIMDOpType::I8x16Add:
+        case SIMDOpType::I16x8Add:
+        case SIMDOpType::I32x4Add:
+        case SIMDOpType::I64x2Add:
+        case SIMDOpType::F32x4Add:
+        case SIMDOpType::F64x2Add:
+            laneValue = m_currentBlock->appendNew<Value>(m_proc, Add, origin(), a, b);
+            break;
+        case SIMDOpType::I8x16Sub:
+        case SIMDOpType::I16x8Sub:
+        case SIMDOpType::I32x4Sub:
+        case SIMDOpType::I64x2Sub:
+        case SIMDOpType::F32x4Sub:
+        case SIMDOpType::F64x2Sub:
+            laneValue = m_currentBlock->appendNew<Value>(m_proc, Sub, origin(), a, b);
+            break;
+        case SIMDOpType::I16x8Mul:
+        case SIMDOpType::I32x4Mul:
+        case SIMDOpType::I64x2Mul:
+        case SIMDOpType::F32x4Mul:
+        case SIMDOpType::F64x2Mul:
+            laneValue = m_currentBlock->appendNew<Value>(m_proc, Mul, origin(), a, b);
+            break;
+        case SIMDOpType::F32x4Div:
+        case SIMDOpType::F64x2Div:
+            laneValue = m_currentBlock->appendNew<Value>(m_proc, Div, origin(), a, b);
+            break;
+        case SIMDOpType::I8x16AddSatS:
+        case SIMDOpType::I16x8AddSatS:
+            laneValue = clamp(m_currentBlock->appendNew<Value>(m_proc, Add, origin(), a, b), signedMin, signedMax);
+            break;
+        case SIMDOpType::I8x16AddSatU:
+        case SIMDOpType::I16x8AddSatU:
+            laneValue = clamp(m_currentBlock->appendNew<Value>(m_proc, Add, origin(), a, b), std::nullopt, unsignedMax);
+            break;
+        case SIMDOpType::I8x16SubSatS:
+        case SIMDOpType::I16x8SubSatS:
+            laneValue = clamp(m_currentBlock->appendNew<Value>(m_proc, Sub, origin(), a, b), signedMin, signedMax);
+            break;
+        case SIMDOpType::I8x16SubSatU:
+        case SIMDOpType::I16x8SubSatU:
+            laneValue = clamp(m_currentBlock->appendNew<Value>(m_proc, Sub, origin(), a, b), 0, std::nullopt);
+            break;
+        case SIMDOpType::I8x16AvgrU:
+        case SIMDOpType::I16x8AvgrU:
+            laneValue = m_currentBlock->appendNew<Value>(m_proc, ZShr, origin(),
+                m_currentBlock->appendNew<Value>(m_proc, Add, origin(),
+                    m_currentBlock->appendNew<Value>(m_proc, Add, origin(), a, b), constant(Int32, 1)),
+                constant(Int32, 1));
+            break;
+        case SIMDOpType::I8x16MinS:
+        case SIMDOpType::I16x8MinS:
+        case SIMDOpType::I32x4MinS:
+        case SIMDOpType::I8x16MinU:
+        case SIMDOpType::I16x8MinU:
+            laneValue = select(LessThan, a, b);
+            break;
+        case SIMDOpType::I32x4MinU:
+            laneValue = select(Below, a, b);
+            break;
+        case SIMDOpType::I8x16MaxS:
+        case SIMDOpType::I16x8MaxS:
+        case SIMDOpType::I32x4MaxS:
+        case SIMDOpType::I8x16MaxU:
+        case SIMDOpType::I16x8MaxU:
+            laneValue = select(GreaterThan, a, b);
+            break;
+        case SIMDOpType::I32x4MaxU:
+            laneValue = select(Above, a, b);
+            break;
+        // Like the scalar min and max, except that a NaN operand makes the result NaN.
+        case SIMDOpType::F32x4Min:
+        case SIMDOpType::F64x2Min:
+            laneValue = select(Equal, m_currentBlock->appendNew<Value>(m_proc, BitOr, origin(), a, b),
+                select(LessThan, a,
+                    m_currentBlock->appendNew<Value>(m_proc, B3::Select, origin(),
+                        m_currentBlock->appendNew<Value>(m_proc, LessThan, origin(), b, a), b,
+                        m_currentBlock->appendNew<Value>(m_proc, Add, origin(), a, b))));
+            break;
+        case SIMDOpType::F32x4Max:
+        case SIMDOpType::F64x2Max:
+            laneValue = select(Equal, m_currentBlock->appendNew<Value>(m_proc, BitAnd, origin(), a, b),
+                select(GreaterThan, a,
+                    m_currentBlock->appendNew<Value>(m_proc, B3::Select, origin(),
+                        m_currentBlock->appendNew<Value>(m_proc, GreaterThan, origin(), b, a), b,
+                        m_currentBlock->appendNew<Value>(m_proc, Add, origin(), a, b))));
+            break;
+        case SIMDOpType::F32x4Pmin:
+        case SIMDOpType::F64x2Pmin:
+            laneValue = m_currentBlock->appendNew<Value>(m_proc, B3::Select, origin(),
+                m_currentBlock->appendNew<Value>(m_proc, LessThan, origin(), b, a), b, a);
+            break;
+        case SIMDOpType::F32x4Pmax:
+        case SIMDOpType::F64x2Pmax:
+            laneValue = select(LessThan, b, a);
+            break;
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+
+        // Comparison results are integers, even for floating-point lanes.
+        SIMDLane resultLane = lane;
+        if (isFloatingPointLane(lane) && isInt(laneValue->type()))
+            resultLane = lane == SIMDLane::F32x4 ? SIMDLane::I32x4 : SIMDLane::I64x2;
+        storeLane(result, resultLane, i, laneValue);
+    }
+    return { };
+}
+
+auto B3IRGenerator::addSIMDBitSelect(ExpressionType left, ExpressionType right, ExpressionType mask, ExpressionType& result) -> PartialResult
+{
+    result = addV128Slot();
+    for (int32_t offset = 0; offset < v128Bytes; offset += v128HalfBytes) {
+        Value* leftHalf = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int64, origin(), left, offset);
+        Value* rightHalf = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int64, origin(), right, offset);
+        Value* maskHalf = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int64, origin(), mask, offset);
+        Value* half = m_currentBlock->appendNew<Value>(m_proc, BitOr, origin(),
+            m_currentBlock->appendNew<Value>(m_proc, BitAnd, origin(), leftHalf, maskHalf),
+            m_currentBlock->appendNew<Value>(m_proc, BitAnd, origin(), rightHalf,
+                m_currentBlock->appendNew<Value>(m_proc, BitXor, origin(), maskHalf, constant(Int64, -1))));
+        m_currentBlock->appendNew<MemoryValue>(m_proc, Store, origin(), half, result, offset);
+    }
+    return { };
+}
+
+static Width atomicWidth(AtomicOpType op)
+{
+    switch (atomicAccessBytes(op)) {
+    case 1:
+        return Width8;
+    case 2:
+        return Width16;
+    case 4:
+        return Width32;
+    case 8:
+        return Width64;
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return Width64;
+}
+
+// Returns the address an atomic access should use, with the offset folded in, or nullptr if the
+// access can never be in bounds. Atomic accesses trap when their address isn't a multiple of their
+// size. Memories are page aligned, so checking the native address is the same as checking the
+// wasm one. Unlike loads and stores, B3 atomics can't be marked as trapping, but in Signaling mode
+// the fault handler recognizes any fault in wasm code, so the bounds check is still implicit.
+Value* B3IRGenerator::emitAtomicAddress(AtomicOpType op, ExpressionType pointer, uint32_t offset)
+{
+    ASSERT(pointer->type() == Int32);
+    uint32_t accessBytes = atomicAccessBytes(op);
+
+    if (UNLIKELY(sumOverflows<uint32_t>(offset, accessBytes))) {
+        B3::PatchpointValue* throwException = m_currentBlock->appendNew<B3::PatchpointValue>(m_proc, B3::Void, origin());
+        throwException->setGenerator([this] (CCallHelpers& jit, const B3::StackmapGenerationParams&) {
+            this->emitExceptionCheck(jit, ExceptionType::OutOfBoundsMemoryAccess);
+        });
+        return nullptr;
+    }
+
+    Value* address = emitCheckAndPreparePointer(pointer, offset, accessBytes);
+    if (offset)
+        address = m_currentBlock->appendNew<Value>(m_proc, Add, origin(), address, m_currentBlock->appendNew<Const64Value>(m_proc, origin(), offset));
+
+    if (accessBytes > 1) {
+        CheckValue* check = m_currentBlock->appendNew<CheckValue>(m_proc, Check, origin(),
+            m_currentBlock->appendNew<Value>(m_proc, BitAnd, origin(), address, m_currentBlock->appendNew<Const64Value>(m_proc, origin(), accessBytes - 1)));
+        check->setGenerator([=] (CCallHelpers& jit, const B3::StackmapGenerationParams&) {
+            this->emitExceptionCheck(jit, ExceptionType::UnalignedMemoryAccess);
+        });
+    }
+    return address;
+}
+
+// B3 accesses narrower than 64 bits operate on Int32s.
+Value* B3IRGenerator::truncateAtomicOperand(AtomicOpType op, Value* value)
+{
+    if (value->type() == Int64 && atomicAccessBytes(op) < 8)
+        return m_currentBlock->appendNew<Value>(m_proc, Trunc, origin(), value);
+    return value;
+}
+
+// B3's subwidth atomics sign extend what they read, but wasm's zero extend.
+Value* B3IRGenerator::zeroExtendAtomicResult(AtomicOpType op, Value* value)
+{
+    uint32_t accessBytes = atomicAccessBytes(op);
+    if (accessBytes < 4)
+        value = m_currentBlock->appendNew<Value>(m_proc, BitAnd, origin(), value, constant(Int32, (1u << (accessBytes * 8)) - 1));
+    if (atomicValueType(op) == I64 && accessBytes < 8)
+        value = m_currentBlock->appendNew<Value>(m_proc, ZExt32, origin(), value);
+    return value;
+}
+
+auto B3IRGenerator::addAtomicLoad(AtomicOpType op, ExpressionType pointer, uint32_t offset, ExpressionType& result) -> PartialResult
+{
+    Value* address = emitAtomicAddress(op, pointer, offset);
+    if (!address) {
+        result = constant(toB3Type(atomicValueType(op)), 0);
+        return { };
+    }
+
+    // A fenced load is a plain load on x86 and a load-acquire on ARM64, which is all that
+    // sequential consistency needs when every atomic store is fenced too.
+    switch (atomicAccessBytes(op)) {
+    case 1:
+        result = m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load8Z), origin(), address, 0, HeapRange::top(), HeapRange::top());
+        break;
+    case 2:
+        result = m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load16Z), origin(), address, 0, HeapRange::top(), HeapRange::top());
+        break;
+    case 4:
+        result = m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load), Int32, origin(), address, 0, HeapRange::top(), HeapRange::top());
+        break;
+    case 8:
+        result = m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load), Int64, origin(), address, 0, HeapRange::top(), HeapRange::top());
+        break;
+    }
+    if (atomicValueType(op) == I64 && atomicAccessBytes(op) < 8)
+        result = m_currentBlock->appendNew<Value>(m_proc, ZExt32, origin(), result);
+    return { };
+}
+
+auto B3IRGenerator::addAtomicStore(AtomicOpType op, ExpressionType pointer, ExpressionType value, uint32_t offset) -> PartialResult
+{
+    Value* address = emitAtomicAddress(op, pointer, offset);
+    if (!address)
+        return { };
+
+    value = truncateAtomicOperand(op, value);
+    B3::Opcode storeOpcode = Store;
+    if (atomicAccessBytes(op) == 1)
+        storeOpcode = Store8;
+    else if (atomicAccessBytes(op) == 2)
+        storeOpcode = Store16;
+    m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(storeOpcode), origin(), value, address, 0, HeapRange::top(), HeapRange::top());
+    return { };
+}
+
+auto B3IRGenerator::addAtomicBinaryRMW(AtomicOpType op, ExpressionType pointer, ExpressionType value, uint32_t offset, ExpressionType& result) -> PartialResult
+{
+    Value* address = emitAtomicAddress(op, pointer, offset);
+    if (!address) {
+        result = constant(toB3Type(atomicValueType(op)), 0);
+        return { };
+    }
+
+    B3::Opcode opcode = AtomicXchg;
+    switch (atomicRMWOp(op)) {
+    case AtomicRMWOp::Add:
+        opcode = AtomicXchgAdd;
+        break;
+    case AtomicRMWOp::Sub:
+        opcode = AtomicXchgSub;
+        break;
+    case AtomicRMWOp::And:
+        opcode = AtomicXchgAnd;
+        break;
+    case AtomicRMWOp::Or:
+        opcode = AtomicXchgOr;
+        break;
+    case AtomicRMWOp::Xor:
+        opcode = AtomicXchgXor;
+        break;
+    case AtomicRMWOp::Xchg:
+        opcode = AtomicXchg;
+        break;
+    case AtomicRMWOp::None:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+
+    Value* oldValue = m_currentBlock->appendNew<AtomicValue>(m_proc, opcode, origin(), atomicWidth(op), truncateAtomicOperand(op, value), address);
+    result = zeroExtendAtomicResult(op, oldValue);
+    return { };
+}
+
+auto B3IRGenerator::addAtomicCompareExchange(AtomicOpType op, ExpressionType pointer, ExpressionType expected, ExpressionType replacement, uint32_t offset, ExpressionType& result) -> PartialResult
+{
+    Value* address = emitAtomicAddress(op, pointer, offset);
+    if (!address) {
+        result = constant(toB3Type(atomicValueType(op)), 0);
+        return { };
+    }
+
+    // Only the accessed bytes of the expected value take part in the comparison. ARM64 compares
+    // whole registers, so drop the rest.
+    expected = truncateAtomicOperand(op, expected);
+    if (atomicAccessBytes(op) < 4)
+        expected = m_currentBlock->appendNew<Value>(m_proc, BitAnd, origin(), expected, constant(Int32, (1u << (atomicAccessBytes(op) * 8)) - 1));
+
+    Value* oldValue = m_currentBlock->appendNew<AtomicValue>(m_proc, AtomicStrongCAS, origin(), atomicWidth(op), expected, truncateAtomicOperand(op, replacement), address);
+    result = zeroExtendAtomicResult(op, oldValue);
+    return { };
+}
+
+// memory.atomic.wait parks the thread in the ParkingLot under the waited-on address, as Atomics.wait
+// does, so wasm and JS code sharing a memory can wake each other. Returns 0 if the thread was woken,
+// 1 if the memory didn't hold the expected value, 2 on timeout, and -1 if the thread can't block.
+template<typename ValueType>
+static int32_t waitOnAddress(void* callFrame, Instance* instance, ValueType* address, ValueType expected, int64_t timeoutInNanoseconds)
+{
+    instance->storeTopCallFrame(callFrame);
+
+    Seconds timeout = timeoutInNanoseconds < 0 ? Seconds::infinity() : Seconds::fromNanoseconds(timeoutInNanoseconds);
+    bool didPassValidation = false;
+    ParkingLot::ParkResult result;
+    bool didBlock = instance->wait(scopedLambda<void()>([&] () {
+        result = ParkingLot::parkConditionally(
+            address,
+            [&] () -> bool {
+                didPassValidation = WTF::atomicLoad(address) == expected;
+                return didPassValidation;
+            },
+            [] () { },
+            MonotonicTime::now() + timeout);
+    }));
+
+    if (!didBlock)
+        return -1;
+    if (!didPassValidation)
+        return 1;
+    if (!result.wasUnparked)
+        return 2;
+    return 0;
+}
+
+auto B3IRGenerator::addAtomicWait(AtomicOpType op, ExpressionType pointer, ExpressionType expected, ExpressionType timeout, uint32_t offset, ExpressionType& result) -> PartialResult
+{
+    Value* address = emitAtomicAddress(op, pointer, offset);
+    if (!address || !m_info.memory.isShared()) {
+        if (address) {
+            B3::PatchpointValue* throwException = m_currentBlock->appendNew<B3::PatchpointValue>(m_proc, B3::Void, origin());
+            throwException->setGenerator([this] (CCallHelpers& jit, const B3::StackmapGenerationParams&) {
+                this->emitExceptionCheck(jit, ExceptionType::WaitOnUnsharedMemory);
+            });
+        }
+        result = constant(Int32, 0);
+        return { };
+    }
+
+    void* waitFunction = op == AtomicOpType::MemoryAtomicWait32
+        ? tagCFunctionPtr<void*>(waitOnAddress<int32_t>, B3CCallPtrTag)
+        : tagCFunctionPtr<void*>(waitOnAddress<int64_t>, B3CCallPtrTag);
+    result = m_currentBlock->appendNew<CCallValue>(m_proc, Int32, origin(),
+        m_currentBlock->appendNew<ConstPtrValue>(m_proc, origin(), waitFunction),
+        m_currentBlock->appendNew<B3::Value>(m_proc, B3::FramePointer, origin()), instanceValue(), address, expected, timeout);
+
+    CheckValue* check = m_currentBlock->appendNew<CheckValue>(m_proc, Check, origin(),
+        m_currentBlock->appendNew<Value>(m_proc, LessThan, origin(), result, constant(Int32, 0)));
+    check->setGenerator([=] (CCallHelpers& jit, const B3::StackmapGenerationParams&) {
+        this->emitExceptionCheck(jit, ExceptionType::WaitNotAllowed);
+    });
+
+    // Another thread may have grown the memory while this one was blocked.
+    restoreWebAssemblyGlobalState(RestoreCachedStackLimit::No, m_info.memory, instanceValue(), m_proc, m_currentBlock);
+    return { };
+}
+
+auto B3IRGenerator::addAtomicNotify(ExpressionType pointer, ExpressionType count, uint32_t offset, ExpressionType& result) -> PartialResult
+{
+    Value* address = emitAtomicAddress(AtomicOpType::MemoryAtomicNotify, pointer, offset);
+    if (!address || !m_info.memory.isShared()) {
+        // No other thread can be waiting on a memory that isn't shared.
+        result = constant(Int32, 0);
+        return { };
+    }
+
+    int32_t (*notify)(void*, uint32_t) = [] (void* address, uint32_t count) -> int32_t {
+        return ParkingLot::unparkCount(address, count);
+    };
+    result = m_currentBlock->appendNew<CCallValue>(m_proc, Int32, origin(),
+        m_currentBlock->appendNew<ConstPtrValue>(m_proc, origin(), tagCFunctionPtr<void*>(notify, B3CCallPtrTag)),
+        address, count);
+    return { };
+}
+
+auto B3IRGenerator::addAtomicFence() -> PartialResult
+{
+    m_currentBlock->appendNew<FenceValue>(m_proc, origin());
+    return { };
+}
+
 void B3IRGenerator::emitTierUpCheck(uint32_t decrementCount, Origin origin)
 {
     if (!m_tierUp)
@@ -944,15 +1967,91 @@ void B3IRGenerator::emitTierUpCheck(uint32_t decrementCount, Origin origin)
     });
 }
 
+void B3IRGenerator::emitLoopTierUpCheck(uint32_t loopIndex, Origin origin)
+{
+    ASSERT(m_tierUp);
+    Value* countDownLocation = constant(pointerType(), reinterpret_cast<uint64_t>(m_tierUp), origin);
+    Value* oldCountDown = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int32, origin, countDownLocation);
+    Value* newCountDown = m_currentBlock->appendNew<Value>(m_proc, Sub, origin, oldCountDown, constant(Int32, TierUpCount::loopDecrement(), origin));
+    m_currentBlock->appendNew<MemoryValue>(m_proc, Store, origin, newCountDown, countDownLocation);
+
+    Vector<Value*> locals;
+    Vector<B3::Type> types;
+    for (Variable* local : m_locals) {
+        locals.append(m_currentBlock->appendNew<VariableValue>(m_proc, B3::Get, origin, local));
+        types.append(local->type());
+    }
+
+    PatchpointValue* patch = m_currentBlock->appendNew<PatchpointValue>(m_proc, B3::Void, origin);
+    Effects effects = Effects::none();
+    // FIXME: we should have a more precise heap range for the tier up count.
+    effects.reads = B3::HeapRange::top();
+    effects.writes = B3::HeapRange::top();
+    effects.exitsSideways = true;
+    patch->effects = effects;
+
+    patch->append(newCountDown, ValueRep::SomeRegister);
+    patch->append(oldCountDown, ValueRep::SomeRegister);
+    patch->append(instanceValue(), ValueRep::SomeRegister);
+    patch->appendColdAnys(locals);
+    patch->setGenerator([=] (CCallHelpers& jit, const StackmapGenerationParams& params) {
+        MacroAssembler::Jump tierUp = jit.branch32(MacroAssembler::Above, params[0].gpr(), params[1].gpr());
+        MacroAssembler::Label tierUpResume = jit.label();
+
+        Vector<OSREntryValue> values;
+        for (unsigned i = 0; i < types.size(); ++i)
+            values.append(OSREntryValue(params[i + 3], types[i]));
+        OSREntryData* osrEntryData = &m_tierUp->addOSREntryData(m_functionIndex, loopIndex, params[2].gpr(), WTFMove(values), params.proc().calleeSaveRegisterAtOffsetList());
+
+        params.addLatePath([=] (CCallHelpers& jit) {
+            tierUp.link(&jit);
+            // The probe either returns here, or leaves this frame for the OSR entry code.
+            jit.probe(OMGPlan::triggerOSREntryNow, osrEntryData);
+            jit.jump(tierUpResume);
+        });
+    });
+}
+
+bool B3IRGenerator::canOSREnterLoop() const
+{
+    // Only the locals are transferred to the OSR entry code, so the loop must be entered with an
+    // empty expression stack in every enclosing block. v128 locals live in stack slots, which the
+    // OSR entry code doesn't know how to fill.
+    if (m_hasV128Locals)
+        return false;
+    if (!m_parser->expressionStack().isEmpty())
+        return false;
+    for (const ControlEntry& entry : m_parser->controlStack()) {
+        if (!entry.enclosedExpressionStack.isEmpty())
+            return false;
+    }
+    return true;
+}
+
 B3IRGenerator::ControlData B3IRGenerator::addLoop(Type signature)
 {
     BasicBlock* body = m_proc.addBlock();
     BasicBlock* continuation = m_proc.addBlock();
+    uint32_t loopIndex = m_loopCount++;
 
     m_currentBlock->appendNewControlValue(m_proc, Jump, origin(), body);
 
+    if (loopIndex == m_loopIndexForOSREntry) {
+        ASSERT(m_compilationMode == CompilationMode::OMGForOSREntryMode);
+        ASSERT(canOSREnterLoop());
+        for (unsigned i = 0; i < m_locals.size(); ++i) {
+            Value* local = m_rootBlock->appendNew<MemoryValue>(m_proc, Load, m_locals[i]->type(), Origin(), m_osrEntryScratchBuffer, safeCast<int32_t>(i * sizeof(uint64_t)));
+            m_rootBlock->appendNew<VariableValue>(m_proc, Set, Origin(), m_locals[i], local);
+        }
+        m_rootBlock->appendNewControlValue(m_proc, Jump, Origin(), body);
+        m_didEmitOSREntry = true;
+    }
+
     m_currentBlock = body;
-    emitTierUpCheck(TierUpCount::loopDecrement(), origin());
+    if (m_tierUp && Options::useWebAssemblyOSR() && canOSREnterLoop())
+        emitLoopTierUpCheck(loopIndex, origin());
+    else
+        emitTierUpCheck(TierUpCount::loopDecrement(), origin());
 
     return ControlData(m_proc, origin(), signature, BlockType::Loop, continuation, body);
 }
@@ -1376,12 +2475,12 @@ void B3IRGenerator::dump(const Vector<ControlEntry>& controlStack, const Express
 
 auto B3IRGenerator::origin() -> Origin
 {
-    OpcodeOrigin origin(m_parser->currentOpcode(), m_parser->currentOpcodeStartingOffset());
-    ASSERT(isValidOpType(static_cast<uint8_t>(origin.opcode())));
+    OpcodeOrigin origin(m_parser->currentOpcode(), m_parser->currentOpcodeIsPrefixed() ? m_parser->currentPrefixedOpcode() : 0, m_parser->currentOpcodeStartingOffset());
+    ASSERT(isValidOpType(static_cast<uint8_t>(origin.opcode())) || m_parser->currentOpcodeIsPrefixed());
     return bitwise_cast<Origin>(origin);
 }
 
-Expected<std::unique_ptr<InternalFunction>, String> parseAndCompile(CompilationContext& compilationContext, const uint8_t* functionStart, size_t functionLength, const Signature& signature, Vector<UnlinkedWasmToWasmCall>& unlinkedWasmToWasmCalls, const ModuleInformation& info, MemoryMode mode, CompilationMode compilationMode, uint32_t functionIndex, TierUpCount* tierUp, ThrowWasmException throwWasmException)
+Expected<std::unique_ptr<InternalFunction>, String> parseAndCompile(CompilationContext& compilationContext, const uint8_t* functionStart, size_t functionLength, const Signature& signature, Vector<UnlinkedWasmToWasmCall>& unlinkedWasmToWasmCalls, const ModuleInformation& info, MemoryMode mode, CompilationMode compilationMode, uint32_t functionIndex, TierUpCount* tierUp, ThrowWasmException throwWasmException, uint64_t* callCount, uint32_t loopIndexForOSREntry)
 {
     auto result = std::make_unique<InternalFunction>();
 
@@ -1405,9 +2504,11 @@ Expected<std::unique_ptr<InternalFunction>, String> parseAndCompile(CompilationC
         ? Options::webAssemblyBBQOptimizationLevel()
         : Options::webAssemblyOMGOptimizationLevel());
 
-    B3IRGenerator irGenerator(info, procedure, result.get(), unlinkedWasmToWasmCalls, mode, compilationMode, functionIndex, tierUp, throwWasmException);
+    B3IRGenerator irGenerator(info, procedure, result.get(), unlinkedWasmToWasmCalls, mode, compilationMode, functionIndex, tierUp, throwWasmException, callCount, loopIndexForOSREntry);
     FunctionParser<B3IRGenerator> parser(irGenerator, functionStart, functionLength, signature, info);
     WASM_FAIL_IF_HELPER_FAILS(parser.parse());
+    if (compilationMode == CompilationMode::OMGForOSREntryMode && !irGenerator.didEmitOSREntry())
+        return makeUnexpected(makeString("WebAssembly.Module failed compiling: loop ", String::number(loopIndexForOSREntry), " to OSR enter is not in function ", String::number(functionIndex)));
 
     irGenerator.insertConstants();
 
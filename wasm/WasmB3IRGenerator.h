@@ -46,6 +46,7 @@ class MemoryInformation;
 enum class CompilationMode {
     BBQMode,
     OMGMode,
+    OMGForOSREntryMode,
 };
 
 struct CompilationContext {
@@ -55,7 +56,7 @@ struct CompilationContext {
     std::unique_ptr<B3::OpaqueByproducts> wasmEntrypointByproducts;
 };
 
-Expected<std::unique_ptr<InternalFunction>, String> parseAndCompile(CompilationContext&, const uint8_t*, size_t, const Signature&, Vector<UnlinkedWasmToWasmCall>&, const ModuleInformation&, MemoryMode, CompilationMode, uint32_t functionIndex, TierUpCount* = nullptr, ThrowWasmException = nullptr);
+Expected<std::unique_ptr<InternalFunction>, String> parseAndCompile(CompilationContext&, const uint8_t*, size_t, const Signature&, Vector<UnlinkedWasmToWasmCall>&, const ModuleInformation&, MemoryMode, CompilationMode, uint32_t functionIndex, TierUpCount* = nullptr, ThrowWasmException = nullptr, uint64_t* callCount = nullptr, uint32_t loopIndexForOSREntry = UINT32_MAX);
 
 } } // namespace JSC::Wasm
 
@@ -38,6 +38,7 @@
 #include "WasmModuleParser.h"
 #include "WasmTierUpCount.h"
 #include "WasmValidate.h"
+#include "WasmWorklist.h"
 #include <wtf/DataLog.h>
 #include <wtf/Locker.h>
 #include <wtf/MonotonicTime.h>
@@ -56,6 +57,8 @@ BBQPlan::BBQPlan(Context* context, Ref<ModuleInformation> info, AsyncWork work,
     , m_state(State::Validated)
     , m_asyncWork(work)
 {
+    if (m_asyncWork == StreamingCompile)
+        m_streamedFunctions.resize(m_moduleInformation->internalFunctionCount());
 }
 
 BBQPlan::BBQPlan(Context* context, Vector<uint8_t>&& source, AsyncWork work, CompletionTask&& task, CreateEmbedderWrapper&& createEmbedderWrapper, ThrowWasmException throwWasmException)
@@ -163,6 +166,11 @@ void BBQPlan::prepare()
         || !tryReserveCapacity(m_compilationContexts, functionLocations.size(), " compilation contexts")
         || !tryReserveCapacity(m_tierUpCounts, functionLocations.size(), " tier-up counts"))
         return;
+    if (Options::useWebAssemblyFunctionProfiling()) {
+        if (!tryReserveCapacity(m_functionProfiles, functionLocations.size(), " function profiles"))
+            return;
+        m_functionProfiles.resize(functionLocations.size());
+    }
 
     m_unlinkedWasmToWasmCalls.resize(functionLocations.size());
     m_wasmInternalFunctions.resize(functionLocations.size());
@@ -202,9 +210,67 @@ void BBQPlan::prepare()
     if (m_moduleInformation->startFunctionIndexSpace && m_moduleInformation->startFunctionIndexSpace >= importFunctionCount)
         m_exportedFunctionIndices.add(*m_moduleInformation->startFunctionIndexSpace - importFunctionCount);
 
+    if (WasmBBQPlanInternal::verbose || Options::reportCompileTimes())
+        m_compilationStartTime = MonotonicTime::now();
+
+    // addStreamedFunction() decides whether to resume the plan based on this state, and a
+    // streaming plan can fail while it is being prepared.
+    auto locker = holdLock(m_lock);
+    if (isComplete())
+        return;
     moveToState(State::Prepared);
 }
 
+void BBQPlan::addStreamedFunction(uint32_t functionIndex, const uint8_t* functionStart, size_t functionLength)
+{
+    ASSERT(m_asyncWork == StreamingCompile);
+    bool shouldResume;
+    {
+        auto locker = holdLock(m_lock);
+        RELEASE_ASSERT(functionIndex == m_streamedFunctionCount);
+        m_streamedFunctions[functionIndex] = { functionStart, functionLength };
+        ++m_streamedFunctionCount;
+        // Until the plan is prepared, the thread preparing it will put it back in the queue.
+        shouldResume = hasBeenPrepared() && !isComplete();
+    }
+    if (shouldResume)
+        ensureWorklist().resume(makeRef(*this));
+}
+
+void BBQPlan::retainStreamedBytes(Vector<uint8_t>&& bytes)
+{
+    ASSERT(m_asyncWork == StreamingCompile);
+    auto locker = holdLock(m_lock);
+    m_retainedStreamedBytes.append(WTFMove(bytes));
+}
+
+void BBQPlan::didFinishStreaming(Ref<ModuleInformation>&& moduleInformation)
+{
+    ASSERT(m_asyncWork == StreamingCompile);
+    bool shouldResume;
+    {
+        auto locker = holdLock(m_lock);
+        RELEASE_ASSERT(m_streamedFunctionCount == m_streamedFunctions.size());
+        m_streamedModuleInformation = WTFMove(moduleInformation);
+        m_didFinishStreaming = true;
+        shouldResume = hasBeenPrepared() && !isComplete();
+    }
+    if (shouldResume)
+        ensureWorklist().resume(makeRef(*this));
+}
+
+void BBQPlan::didFailStreaming(String&& errorMessage)
+{
+    ASSERT(m_asyncWork == StreamingCompile);
+    auto locker = holdLock(m_lock);
+    if (!m_errorMessage)
+        fail(locker, WTFMove(errorMessage));
+    // Stop any thread still compiling functions that already arrived, and wait for it: function
+    // bodies point into the streaming parser's buffer, which goes away once streaming fails.
+    m_currentIndex = m_streamedFunctions.size();
+    m_activeThreadsFinished.wait(m_lock, [&] { return !m_numberOfActiveThreads; });
+}
+
 // We don't have a semaphore class... and this does kinda interesting things.
 class BBQPlan::ThreadCountHolder {
 public:
@@ -219,8 +285,11 @@ public:
     {
         LockHolder locker(m_plan.m_lock);
         m_plan.m_numberOfActiveThreads--;
+        if (!m_plan.m_numberOfActiveThreads)
+            m_plan.m_activeThreadsFinished.notifyAll();
 
-        if (!m_plan.m_numberOfActiveThreads && !m_plan.hasWork())
+        // A streaming plan can run out of work before it has compiled every function.
+        if (!m_plan.m_numberOfActiveThreads && !m_plan.hasWork() && m_plan.m_state >= State::Compiled)
             m_plan.complete(locker);
     }
 
@@ -254,13 +323,21 @@ void BBQPlan::compileFunctions(CompilationEffort effort)
                     moveToState(State::Compiled);
                 return;
             }
+            if (m_asyncWork == StreamingCompile && m_currentIndex >= m_streamedFunctionCount)
+                return;
             functionIndex = m_currentIndex;
             ++m_currentIndex;
         }
 
-        const uint8_t* functionStart = m_source + functionLocations[functionIndex].start;
-        size_t functionLength = functionLocations[functionIndex].end - functionLocations[functionIndex].start;
-        ASSERT(functionLength <= m_sourceLength);
+        const uint8_t* functionStart;
+        size_t functionLength;
+        if (m_asyncWork == StreamingCompile) {
+            std::tie(functionStart, functionLength) = m_streamedFunctions[functionIndex];
+        } else {
+            functionStart = m_source + functionLocations[functionIndex].start;
+            functionLength = functionLocations[functionIndex].end - functionLocations[functionIndex].start;
+            ASSERT(functionLength <= m_sourceLength);
+        }
         SignatureIndex signatureIndex = m_moduleInformation->internalFunctionSignatureIndices[functionIndex];
         const Signature& signature = SignatureInformation::get(signatureIndex);
         unsigned functionIndexSpace = m_wasmToWasmExitStubs.size() + functionIndex;
@@ -269,7 +346,13 @@ void BBQPlan::compileFunctions(CompilationEffort effort)
 
         m_unlinkedWasmToWasmCalls[functionIndex] = Vector<UnlinkedWasmToWasmCall>();
         TierUpCount* tierUp = Options::useBBQTierUpChecks() ? &m_tierUpCounts[functionIndex] : nullptr;
-        auto parseAndCompileResult = parseAndCompile(m_compilationContexts[functionIndex], functionStart, functionLength, signature, m_unlinkedWasmToWasmCalls[functionIndex], m_moduleInformation.get(), m_mode, CompilationMode::BBQMode, functionIndex, tierUp, m_throwWasmException);
+        FunctionProfile* profile = m_functionProfiles.isEmpty() ? nullptr : &m_functionProfiles[functionIndex];
+        MonotonicTime startTime;
+        if (profile)
+            startTime = MonotonicTime::now();
+        auto parseAndCompileResult = parseAndCompile(m_compilationContexts[functionIndex], functionStart, functionLength, signature, m_unlinkedWasmToWasmCalls[functionIndex], m_moduleInformation.get(), m_mode, CompilationMode::BBQMode, functionIndex, tierUp, m_throwWasmException, profile ? &profile->callCount : nullptr);
+        if (profile)
+            profile->bbqCompileTime = MonotonicTime::now() - startTime;
 
         if (UNLIKELY(!parseAndCompileResult)) {
             auto locker = holdLock(m_lock);
@@ -299,6 +382,20 @@ void BBQPlan::complete(const AbstractLocker& locker)
     dataLogLnIf(WasmBBQPlanInternal::verbose, "Starting Completion");
 
     if (!failed() && m_state == State::Compiled) {
+        // Functions were compiled against the sections preceding Code. The complete module
+        // information also has the name section and the source OMG recompiles from.
+        if (m_asyncWork == StreamingCompile)
+            m_moduleInformation = m_streamedModuleInformation.releaseNonNull();
+
+        if (WasmBBQPlanInternal::verbose || Options::reportCompileTimes()) {
+            size_t bytesCompiled = 0;
+            for (const auto& location : m_moduleInformation->functionLocationInBinary)
+                bytesCompiled += location.end - location.start;
+            Seconds compileTime = MonotonicTime::now() - m_compilationStartTime;
+            dataLogLn("Took ", compileTime.milliseconds(), " ms to BBQ compile ", bytesCompiled, " bytes of function bodies (",
+                static_cast<double>(bytesCompiled) / MB / compileTime.seconds(), " MB/s)");
+        }
+
         for (uint32_t functionIndex = 0; functionIndex < m_moduleInformation->functionLocationInBinary.size(); functionIndex++) {
             CompilationContext& context = m_compilationContexts[functionIndex];
             SignatureIndex signatureIndex = m_moduleInformation->internalFunctionSignatureIndices[functionIndex];
@@ -310,6 +407,9 @@ void BBQPlan::complete(const AbstractLocker& locker)
                     return;
                 }
 
+                if (!m_functionProfiles.isEmpty())
+                    m_functionProfiles[functionIndex].bbqCodeSize = linkBuffer.size();
+
                 m_wasmInternalFunctions[functionIndex]->entrypoint.compilation = std::make_unique<B3::Compilation>(
                     FINALIZE_CODE(linkBuffer, B3CompilationPtrTag, "WebAssembly function[%i] %s", functionIndex, signature.toString().ascii().data()),
                     WTFMove(context.wasmEntrypointByproducts));
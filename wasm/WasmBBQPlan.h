@@ -29,11 +29,13 @@
 
 #include "CompilationResult.h"
 #include "WasmB3IRGenerator.h"
+#include "WasmFunctionProfile.h"
 #include "WasmModuleInformation.h"
 #include "WasmPlan.h"
 #include "WasmTierUpCount.h"
 #include <wtf/Bag.h>
 #include <wtf/Function.h>
+#include <wtf/MonotonicTime.h>
 #include <wtf/SharedTask.h>
 #include <wtf/ThreadSafeRefCounted.h>
 #include <wtf/Vector.h>
@@ -47,7 +49,9 @@ namespace Wasm {
 class BBQPlan final : public Plan {
 public:
     using Base = Plan;
-    enum AsyncWork : uint8_t { FullCompile, Validation };
+    // StreamingCompile plans start from the sections preceding Code and receive each validated
+    // function body through addStreamedFunction() as it arrives.
+    enum AsyncWork : uint8_t { FullCompile, Validation, StreamingCompile };
 
     // Note: CompletionTask should not hold a reference to the Plan otherwise there will be a reference cycle.
     BBQPlan(Context*, Ref<ModuleInformation>, AsyncWork, CompletionTask&&, CreateEmbedderWrapper&&, ThrowWasmException);
@@ -64,6 +68,14 @@ public:
     template<typename Functor>
     void initializeCallees(const Functor&);
 
+    // The bytes are not copied. They must stay alive until the plan is done, either in the
+    // ModuleInformation given to didFinishStreaming() or through retainStreamedBytes(), or until
+    // didFailStreaming() returns.
+    void addStreamedFunction(uint32_t functionIndex, const uint8_t*, size_t);
+    void retainStreamedBytes(Vector<uint8_t>&&);
+    void didFinishStreaming(Ref<ModuleInformation>&&);
+    void didFailStreaming(String&&);
+
     Vector<Export>& exports() const
     {
         RELEASE_ASSERT(!failed() && !hasWork());
@@ -106,6 +118,12 @@ public:
         return WTFMove(m_tierUpCounts);
     }
 
+    Vector<FunctionProfile> takeFunctionProfiles()
+    {
+        RELEASE_ASSERT(!failed() && !hasWork());
+        return WTFMove(m_functionProfiles);
+    }
+
     enum class State : uint8_t {
         Initial,
         Validated,
@@ -118,6 +136,9 @@ public:
     {
         if (m_asyncWork == AsyncWork::Validation)
             return m_state < State::Validated;
+        // A streaming plan that has compiled everything received so far waits for more bytes.
+        if (m_asyncWork == AsyncWork::StreamingCompile && m_state == State::Prepared)
+            return m_currentIndex < m_streamedFunctionCount || m_didFinishStreaming;
         return m_state < State::Compiled;
     }
     void work(CompilationEffort) override;
@@ -143,6 +164,8 @@ private:
     HashMap<uint32_t, std::unique_ptr<InternalFunction>, typename DefaultHash<uint32_t>::Hash, WTF::UnsignedWithZeroKeyHashTraits<uint32_t>> m_embedderToWasmInternalFunctions;
     Vector<CompilationContext> m_compilationContexts;
     Vector<TierUpCount> m_tierUpCounts;
+    // Empty unless useWebAssemblyFunctionProfiling is set.
+    Vector<FunctionProfile> m_functionProfiles;
 
     Vector<Vector<UnlinkedWasmToWasmCall>> m_unlinkedWasmToWasmCalls;
     State m_state;
@@ -150,6 +173,17 @@ private:
     const AsyncWork m_asyncWork;
     uint8_t m_numberOfActiveThreads { 0 };
     uint32_t m_currentIndex { 0 };
+    MonotonicTime m_compilationStartTime;
+
+    // Only used by StreamingCompile plans. Function bodies point into the streaming parser's
+    // buffer, or into buffers it has since let go of, which are kept here.
+    Vector<std::pair<const uint8_t*, size_t>> m_streamedFunctions;
+    Vector<Vector<uint8_t>> m_retainedStreamedBytes;
+    Condition m_activeThreadsFinished;
+    uint32_t m_streamedFunctionCount { 0 };
+    bool m_didFinishStreaming { false };
+    // The complete module, including sections after Code such as the name section.
+    RefPtr<ModuleInformation> m_streamedModuleInformation;
 };
 
 
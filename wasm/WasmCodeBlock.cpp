@@ -41,13 +41,38 @@ Ref<CodeBlock> CodeBlock::create(Context* context, MemoryMode mode, ModuleInform
     return adoptRef(*result);
 }
 
+Ref<CodeBlock> CodeBlock::create(Context* context, MemoryMode mode, ModuleInformation& moduleInformation, Ref<BBQPlan>&& plan)
+{
+    auto* result = new (NotNull, fastMalloc(sizeof(CodeBlock))) CodeBlock(context, mode, moduleInformation, WTFMove(plan));
+    return adoptRef(*result);
+}
+
 CodeBlock::CodeBlock(Context* context, MemoryMode mode, ModuleInformation& moduleInformation, CreateEmbedderWrapper&& createEmbedderWrapper, ThrowWasmException throwWasmException)
     : m_calleeCount(moduleInformation.internalFunctionCount())
     , m_mode(mode)
 {
-    RefPtr<CodeBlock> protectedThis = this;
+    m_plan = adoptRef(*new BBQPlan(context, makeRef(moduleInformation), BBQPlan::FullCompile, createPlanCompletionTask(), WTFMove(createEmbedderWrapper), throwWasmException));
+    m_plan->setMode(mode);
 
-    m_plan = adoptRef(*new BBQPlan(context, makeRef(moduleInformation), BBQPlan::FullCompile, createSharedTask<Plan::CallbackType>([this, protectedThis = WTFMove(protectedThis)] (Plan&) {
+    auto& worklist = Wasm::ensureWorklist();
+    // Note, immediately after we enqueue the plan, there is a chance the above callback will be called.
+    worklist.enqueue(makeRef(*m_plan.get()));
+}
+
+CodeBlock::CodeBlock(Context* context, MemoryMode mode, ModuleInformation& moduleInformation, Ref<BBQPlan>&& plan)
+    : m_calleeCount(moduleInformation.internalFunctionCount())
+    , m_mode(mode)
+{
+    ASSERT(plan->mode() == mode);
+    m_plan = WTFMove(plan);
+    // The plan may already be running, or even be complete, in which case the task runs right away.
+    m_plan->addCompletionTask(context, createPlanCompletionTask());
+}
+
+RefPtr<WTF::SharedTask<void(Plan&)>> CodeBlock::createPlanCompletionTask()
+{
+    RefPtr<CodeBlock> protectedThis = this;
+    return createSharedTask<Plan::CallbackType>([this, protectedThis = WTFMove(protectedThis)] (Plan&) {
         auto locker = holdLock(m_lock);
         if (m_plan->failed()) {
             m_errorMessage = m_plan->errorMessage();
@@ -58,6 +83,7 @@ CodeBlock::CodeBlock(Context* context, MemoryMode mode, ModuleInformation& modul
         // FIXME: we should eventually collect the BBQ code.
         m_callees.resize(m_calleeCount);
         m_optimizedCallees.resize(m_calleeCount);
+        m_osrEntryCallees.resize(m_calleeCount);
         m_wasmIndirectCallEntryPoints.resize(m_calleeCount);
 
         m_plan->initializeCallees([&] (unsigned calleeIndex, RefPtr<Wasm::Callee>&& embedderEntrypointCallee, Ref<Wasm::Callee>&& wasmEntrypointCallee) {
@@ -72,14 +98,10 @@ CodeBlock::CodeBlock(Context* context, MemoryMode mode, ModuleInformation& modul
         m_wasmToWasmExitStubs = m_plan->takeWasmToWasmExitStubs();
         m_wasmToWasmCallsites = m_plan->takeWasmToWasmCallsites();
         m_tierUpCounts = m_plan->takeTierUpCounts();
+        m_functionProfiles = m_plan->takeFunctionProfiles();
 
         setCompilationFinished();
-    }), WTFMove(createEmbedderWrapper), throwWasmException));
-    m_plan->setMode(mode);
-
-    auto& worklist = Wasm::ensureWorklist();
-    // Note, immediately after we enqueue the plan, there is a chance the above callback will be called.
-    worklist.enqueue(makeRef(*m_plan.get()));
+    });
 }
 
 CodeBlock::~CodeBlock() { }
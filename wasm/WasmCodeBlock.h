@@ -29,6 +29,7 @@
 
 #include "MacroAssemblerCodeRef.h"
 #include "WasmEmbedder.h"
+#include "WasmFunctionProfile.h"
 #include "WasmTierUpCount.h"
 #include <wtf/Lock.h>
 #include <wtf/RefPtr.h>
@@ -44,6 +45,7 @@ class Callee;
 struct Context;
 class BBQPlan;
 class OMGPlan;
+class Plan;
 struct ModuleInformation;
 struct UnlinkedWasmToWasmCall;
 enum class MemoryMode : uint8_t;
@@ -53,6 +55,8 @@ public:
     typedef void CallbackType(Ref<CodeBlock>&&);
     using AsyncCompilationCallback = RefPtr<WTF::SharedTask<CallbackType>>;
     static Ref<CodeBlock> create(Context*, MemoryMode, ModuleInformation&, CreateEmbedderWrapper&&, ThrowWasmException);
+    // Takes over a plan that is already compiling the module, such as a streaming one.
+    static Ref<CodeBlock> create(Context*, MemoryMode, ModuleInformation&, Ref<BBQPlan>&&);
 
     void waitUntilFinished();
     void compileAsync(Context*, AsyncCompilationCallback&&);
@@ -108,6 +112,23 @@ public:
         return m_tierUpCounts[functionIndex];
     }
 
+    // Only populated when the CodeBlock was compiled with useWebAssemblyFunctionProfiling set.
+    bool hasFunctionProfiles() const { return !m_functionProfiles.isEmpty(); }
+    const FunctionProfile& functionProfile(uint32_t functionIndex) const { return m_functionProfiles[functionIndex]; }
+
+    bool hasOptimizedCode(uint32_t functionIndex)
+    {
+        auto locker = holdLock(m_lock);
+        return !!m_optimizedCallees[functionIndex];
+    }
+
+    // OMG code that enters the function at the loop recorded in its TierUpCount.
+    RefPtr<Callee> osrEntryCallee(uint32_t functionIndex)
+    {
+        auto locker = holdLock(m_lock);
+        return m_osrEntryCallees[functionIndex];
+    }
+
     bool isSafeToRun(MemoryMode);
 
     MemoryMode mode() const { return m_mode; }
@@ -117,14 +138,18 @@ private:
     friend class OMGPlan;
 
     CodeBlock(Context*, MemoryMode, ModuleInformation&, CreateEmbedderWrapper&&, ThrowWasmException);
+    CodeBlock(Context*, MemoryMode, ModuleInformation&, Ref<BBQPlan>&&);
+    RefPtr<WTF::SharedTask<void(Plan&)>> createPlanCompletionTask();
     void setCompilationFinished();
     unsigned m_calleeCount;
     MemoryMode m_mode;
     Vector<RefPtr<Callee>> m_callees;
     Vector<RefPtr<Callee>> m_optimizedCallees;
+    Vector<RefPtr<Callee>> m_osrEntryCallees;
     HashMap<uint32_t, RefPtr<Callee>, typename DefaultHash<uint32_t>::Hash, WTF::UnsignedWithZeroKeyHashTraits<uint32_t>> m_embedderCallees;
     Vector<MacroAssemblerCodePtr<WasmEntryPtrTag>> m_wasmIndirectCallEntryPoints;
     Vector<TierUpCount> m_tierUpCounts;
+    Vector<FunctionProfile> m_functionProfiles;
     Vector<Vector<UnlinkedWasmToWasmCall>> m_wasmToWasmCallsites;
     Vector<MacroAssemblerCodeRef<WasmEntryPtrTag>> m_wasmToWasmExitStubs;
     RefPtr<BBQPlan> m_plan;
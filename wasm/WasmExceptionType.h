@@ -40,7 +40,10 @@ namespace Wasm {
     macro(Unreachable, "Unreachable code should not be executed") \
     macro(DivisionByZero, "Division by zero") \
     macro(IntegerOverflow, "Integer overflow") \
-    macro(StackOverflow, "Stack overflow")
+    macro(StackOverflow, "Stack overflow") \
+    macro(UnalignedMemoryAccess, "Unaligned atomic memory access") \
+    macro(WaitOnUnsharedMemory, "memory.atomic.wait on a memory that isn't shared") \
+    macro(WaitNotAllowed, "memory.atomic.wait isn't allowed on this thread")
 
 enum class ExceptionType : uint32_t {
 #define MAKE_ENUM(enumName, error) enumName,
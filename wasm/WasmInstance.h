@@ -34,17 +34,21 @@
 #include <wtf/Optional.h>
 #include <wtf/Ref.h>
 #include <wtf/RefPtr.h>
+#include <wtf/ScopedLambda.h>
 #include <wtf/ThreadSafeRefCounted.h>
 
 namespace JSC { namespace Wasm {
 
 struct Context;
 
-class Instance : public ThreadSafeRefCounted<Instance>, public CanMakeWeakPtr<Instance> {
+class Instance : public ThreadSafeRefCounted<Instance> {
 public:
     using StoreTopCallFrameCallback = WTF::Function<void(void*)>;
+    // Runs the blocking part of memory.atomic.wait. Returns false, without running it, if the
+    // embedder doesn't allow the current thread to block.
+    using WaitCallback = WTF::Function<bool(const ScopedLambda<void()>&)>;
 
-    static Ref<Instance> create(Context*, Ref<Module>&&, EntryFrame** pointerToTopEntryFrame, void** pointerToActualStackLimit, StoreTopCallFrameCallback&&);
+    static Ref<Instance> create(Context*, Ref<Module>&&, EntryFrame** pointerToTopEntryFrame, void** pointerToActualStackLimit, StoreTopCallFrameCallback&&, WaitCallback&&);
 
     void finalizeCreation(void* owner, Ref<CodeBlock>&& codeBlock)
     {
@@ -71,6 +75,8 @@ public:
 
     void setMemory(Ref<Memory>&& memory)
     {
+        if (m_memory)
+            m_memory->unregisterInstance(this);
         m_memory = WTFMove(memory);
         m_memory.get()->registerInstance(this);
         updateCachedMemory();
@@ -136,8 +142,22 @@ public:
         m_storeTopCallFrame(callFrame);
     }
 
+    bool wait(const ScopedLambda<void()>& block)
+    {
+        return m_wait(block);
+    }
+
+    // Carries a function's locals from a BBQ loop into OMG OSR entry code, which reads them before
+    // it can run anything else on this instance.
+    uint64_t* osrEntryScratchBuffer(size_t size)
+    {
+        if (m_osrEntryScratchBuffer.size() < size)
+            m_osrEntryScratchBuffer.grow(size);
+        return m_osrEntryScratchBuffer.data();
+    }
+
 private:
-    Instance(Context*, Ref<Module>&&, EntryFrame**, void**, StoreTopCallFrameCallback&&);
+    Instance(Context*, Ref<Module>&&, EntryFrame**, void**, StoreTopCallFrameCallback&&, WaitCallback&&);
     
     static size_t allocationSize(Checked<size_t> numImportFunctions)
     {
@@ -156,6 +176,8 @@ private:
     void** m_pointerToActualStackLimit { nullptr };
     void* m_cachedStackLimit { bitwise_cast<void*>(std::numeric_limits<uintptr_t>::max()) };
     StoreTopCallFrameCallback m_storeTopCallFrame;
+    WaitCallback m_wait;
+    Vector<uint64_t> m_osrEntryScratchBuffer;
     unsigned m_numImportFunctions { 0 };
 };
 
@@ -42,10 +42,11 @@
 
 #include <cstring>
 #include <mutex>
+#include <sys/mman.h>
+#include <sys/resource.h>
 
 namespace JSC { namespace Wasm {
 
-// FIXME: We could be smarter about memset / mmap / madvise. https://bugs.webkit.org/show_bug.cgi?id=170343
 // FIXME: Give up some of the cached fast memories if the GC determines it's easy to get them back, and they haven't been used in a while. https://bugs.webkit.org/show_bug.cgi?id=170773
 // FIXME: Limit slow memory size. https://bugs.webkit.org/show_bug.cgi?id=170825
 
@@ -55,6 +56,41 @@ constexpr bool verbose = false;
 
 NEVER_INLINE NO_RETURN_DUE_TO_CRASH void webAssemblyCouldntGetFastMemory() { CRASH(); }
 
+// Returns pages to the OS and leaves them reading back as zero, without touching them now. They are
+// only faulted in again, already zeroed, once the next user of the memory writes to them.
+static void zeroAndDecommitPages(void* base, size_t bytes)
+{
+    if (!bytes)
+        return;
+#if OS(LINUX)
+    bool failed = madvise(base, bytes, MADV_DONTNEED);
+#else
+    bool failed = mmap(base, bytes, PROT_READ | PROT_WRITE, MAP_FIXED | MAP_PRIVATE | MAP_ANON, -1, 0) == MAP_FAILED;
+#endif
+    if (failed) {
+        dataLog("decommitting fast memory failed: ", strerror(errno), "\n");
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
+static unsigned fastMemoryPoolLimit()
+{
+    if (unsigned count = Options::maxNumWebAssemblyFastMemories())
+        return count;
+
+    // Fast memories are carved out of the primitive Gigacage when it is enabled, which only has
+    // room for a handful of them.
+    if (Gigacage::isEnabled(Gigacage::Primitive))
+        return 4;
+
+    // Otherwise leave at least three quarters of the user address space for everything else.
+    size_t addressSpace = static_cast<size_t>(1) << 47;
+    struct rlimit limit;
+    if (!getrlimit(RLIMIT_AS, &limit) && limit.rlim_cur != RLIM_INFINITY)
+        addressSpace = std::min<size_t>(addressSpace, limit.rlim_cur);
+    return static_cast<unsigned>(std::max<size_t>(1, addressSpace / 4 / Memory::fastMappedBytes()));
+}
+
 struct MemoryResult {
     enum Kind {
         Success,
@@ -96,7 +132,7 @@ struct MemoryResult {
 class MemoryManager {
 public:
     MemoryManager()
-        : m_maxFastMemoryCount(Options::maxNumWebAssemblyFastMemories())
+        : m_maxFastMemoryCount(fastMemoryPoolLimit())
     {
     }
     
@@ -104,12 +140,17 @@ public:
     {
         MemoryResult result = [&] {
             auto holder = holdLock(m_lock);
-            if (m_fastMemories.size() >= m_maxFastMemoryCount)
-                return MemoryResult(nullptr, MemoryResult::SyncTryToReclaimMemory);
-            
-            void* result = Gigacage::tryAllocateZeroedVirtualPages(Gigacage::Primitive, Memory::fastMappedBytes());
-            if (!result)
-                return MemoryResult(nullptr, MemoryResult::SyncTryToReclaimMemory);
+            void* result = nullptr;
+            if (!m_freeFastMemories.isEmpty())
+                result = m_freeFastMemories.takeLast();
+            else {
+                if (m_fastMemories.size() >= m_maxFastMemoryCount)
+                    return MemoryResult(nullptr, MemoryResult::SyncTryToReclaimMemory);
+
+                result = Gigacage::tryAllocateZeroedVirtualPages(Gigacage::Primitive, Memory::fastMappedBytes());
+                if (!result)
+                    return MemoryResult(nullptr, MemoryResult::SyncTryToReclaimMemory);
+            }
             
             m_fastMemories.append(result);
             
@@ -124,12 +165,15 @@ public:
         return result;
     }
     
-    void freeFastMemory(void* basePtr)
+    // Fast memory reservations are kept for the next Memory rather than unmapped. Only the first
+    // usedBytes could have been written to; the rest has been PROT_NONE since the memory was created.
+    void freeFastMemory(void* basePtr, size_t usedBytes)
     {
+        zeroAndDecommitPages(basePtr, usedBytes);
         {
             auto holder = holdLock(m_lock);
-            Gigacage::freeVirtualPages(Gigacage::Primitive, basePtr, Memory::fastMappedBytes());
             m_fastMemories.removeFirst(basePtr);
+            m_freeFastMemories.append(basePtr);
         }
         
         if (Options::logWebAssemblyMemory())
@@ -189,13 +233,16 @@ public:
     
     void dump(PrintStream& out) const
     {
-        out.print("fast memories =  ", m_fastMemories.size(), "/", m_maxFastMemoryCount, ", bytes = ", m_physicalBytes, "/", memoryLimit());
+        out.print("fast memories =  ", m_fastMemories.size(), "/", m_maxFastMemoryCount, " (", m_freeFastMemories.size(), " pooled), bytes = ", m_physicalBytes, "/", memoryLimit());
     }
     
 private:
     Lock m_lock;
     unsigned m_maxFastMemoryCount { 0 };
+    // Live fast memories. Together with m_freeFastMemories, these never exceed m_maxFastMemoryCount.
     Vector<void*> m_fastMemories;
+    // Reservations whose previous Memory died. They are read+write and zeroed, ready for reuse.
+    Vector<void*> m_freeFastMemories;
     size_t m_physicalBytes { 0 };
 };
 
@@ -243,9 +290,10 @@ Memory::Memory()
 {
 }
 
-Memory::Memory(PageCount initial, PageCount maximum, Function<void(NotifyPressure)>&& notifyMemoryPressure, Function<void(SyncTryToReclaim)>&& syncTryToReclaimMemory, WTF::Function<void(GrowSuccess, PageCount, PageCount)>&& growSuccessCallback)
+Memory::Memory(PageCount initial, PageCount maximum, MemorySharingMode sharingMode, Function<void(NotifyPressure)>&& notifyMemoryPressure, Function<void(SyncTryToReclaim)>&& syncTryToReclaimMemory, WTF::Function<void(GrowSuccess, PageCount, PageCount)>&& growSuccessCallback)
     : m_initial(initial)
     , m_maximum(maximum)
+    , m_sharingMode(sharingMode)
     , m_notifyMemoryPressure(WTFMove(notifyMemoryPressure))
     , m_syncTryToReclaimMemory(WTFMove(syncTryToReclaimMemory))
     , m_growSuccessCallback(WTFMove(growSuccessCallback))
@@ -255,13 +303,14 @@ Memory::Memory(PageCount initial, PageCount maximum, Function<void(NotifyPressur
     dataLogLnIf(verbose, "Memory::Memory allocating ", *this);
 }
 
-Memory::Memory(void* memory, PageCount initial, PageCount maximum, size_t mappedCapacity, MemoryMode mode, Function<void(NotifyPressure)>&& notifyMemoryPressure, Function<void(SyncTryToReclaim)>&& syncTryToReclaimMemory, WTF::Function<void(GrowSuccess, PageCount, PageCount)>&& growSuccessCallback)
+Memory::Memory(void* memory, PageCount initial, PageCount maximum, size_t mappedCapacity, MemoryMode mode, MemorySharingMode sharingMode, Function<void(NotifyPressure)>&& notifyMemoryPressure, Function<void(SyncTryToReclaim)>&& syncTryToReclaimMemory, WTF::Function<void(GrowSuccess, PageCount, PageCount)>&& growSuccessCallback)
     : m_memory(memory)
     , m_size(initial.bytes())
     , m_initial(initial)
     , m_maximum(maximum)
     , m_mappedCapacity(mappedCapacity)
     , m_mode(mode)
+    , m_sharingMode(sharingMode)
     , m_notifyMemoryPressure(WTFMove(notifyMemoryPressure))
     , m_syncTryToReclaimMemory(WTFMove(syncTryToReclaimMemory))
     , m_growSuccessCallback(WTFMove(growSuccessCallback))
@@ -274,10 +323,11 @@ RefPtr<Memory> Memory::create()
     return adoptRef(new Memory());
 }
 
-RefPtr<Memory> Memory::create(PageCount initial, PageCount maximum, WTF::Function<void(NotifyPressure)>&& notifyMemoryPressure, WTF::Function<void(SyncTryToReclaim)>&& syncTryToReclaimMemory, WTF::Function<void(GrowSuccess, PageCount, PageCount)>&& growSuccessCallback)
+RefPtr<Memory> Memory::create(PageCount initial, PageCount maximum, MemorySharingMode sharingMode, WTF::Function<void(NotifyPressure)>&& notifyMemoryPressure, WTF::Function<void(SyncTryToReclaim)>&& syncTryToReclaimMemory, WTF::Function<void(GrowSuccess, PageCount, PageCount)>&& growSuccessCallback)
 {
     ASSERT(initial);
     RELEASE_ASSERT(!maximum || maximum >= initial); // This should be guaranteed by our caller.
+    RELEASE_ASSERT(sharingMode == MemorySharingMode::Default || maximum); // Shared memories always declare a maximum.
 
     const size_t initialBytes = initial.bytes();
     const size_t maximumBytes = maximum ? maximum.bytes() : 0;
@@ -285,7 +335,7 @@ RefPtr<Memory> Memory::create(PageCount initial, PageCount maximum, WTF::Functio
     if (maximum && !maximumBytes) {
         // User specified a zero maximum, initial size must also be zero.
         RELEASE_ASSERT(!initialBytes);
-        return adoptRef(new Memory(initial, maximum, WTFMove(notifyMemoryPressure), WTFMove(syncTryToReclaimMemory), WTFMove(growSuccessCallback)));
+        return adoptRef(new Memory(initial, maximum, sharingMode, WTFMove(notifyMemoryPressure), WTFMove(syncTryToReclaimMemory), WTFMove(growSuccessCallback)));
     }
     
     bool done = tryAllocate(
@@ -312,21 +362,24 @@ RefPtr<Memory> Memory::create(PageCount initial, PageCount maximum, WTF::Functio
             RELEASE_ASSERT_NOT_REACHED();
         }
 
-        return adoptRef(new Memory(fastMemory, initial, maximum, Memory::fastMappedBytes(), MemoryMode::Signaling, WTFMove(notifyMemoryPressure), WTFMove(syncTryToReclaimMemory), WTFMove(growSuccessCallback)));
+        return adoptRef(new Memory(fastMemory, initial, maximum, Memory::fastMappedBytes(), MemoryMode::Signaling, sharingMode, WTFMove(notifyMemoryPressure), WTFMove(syncTryToReclaimMemory), WTFMove(growSuccessCallback)));
     }
     
     if (UNLIKELY(Options::crashIfWebAssemblyCantFastMemory()))
         webAssemblyCouldntGetFastMemory();
 
-    if (!initialBytes)
-        return adoptRef(new Memory(initial, maximum, WTFMove(notifyMemoryPressure), WTFMove(syncTryToReclaimMemory), WTFMove(growSuccessCallback)));
+    // Other agents may hold on to a shared memory's buffer, so it can never move. Reserve its
+    // maximum size up front and grow it in place.
+    size_t reservedBytes = sharingMode == MemorySharingMode::Shared ? maximumBytes : initialBytes;
+    if (!reservedBytes)
+        return adoptRef(new Memory(initial, maximum, sharingMode, WTFMove(notifyMemoryPressure), WTFMove(syncTryToReclaimMemory), WTFMove(growSuccessCallback)));
     
-    void* slowMemory = Gigacage::tryAllocateZeroedVirtualPages(Gigacage::Primitive, initialBytes);
+    void* slowMemory = Gigacage::tryAllocateZeroedVirtualPages(Gigacage::Primitive, reservedBytes);
     if (!slowMemory) {
         memoryManager().freePhysicalBytes(initialBytes);
         return nullptr;
     }
-    return adoptRef(new Memory(slowMemory, initial, maximum, initialBytes, MemoryMode::BoundsChecking, WTFMove(notifyMemoryPressure), WTFMove(syncTryToReclaimMemory), WTFMove(growSuccessCallback)));
+    return adoptRef(new Memory(slowMemory, initial, maximum, reservedBytes, MemoryMode::BoundsChecking, sharingMode, WTFMove(notifyMemoryPressure), WTFMove(syncTryToReclaimMemory), WTFMove(growSuccessCallback)));
 }
 
 Memory::~Memory()
@@ -339,10 +392,10 @@ Memory::~Memory()
                 dataLog("mprotect failed: ", strerror(errno), "\n");
                 RELEASE_ASSERT_NOT_REACHED();
             }
-            memoryManager().freeFastMemory(m_memory);
+            memoryManager().freeFastMemory(m_memory, m_size);
             break;
         case MemoryMode::BoundsChecking:
-            Gigacage::freeVirtualPages(Gigacage::Primitive, m_memory, m_size);
+            Gigacage::freeVirtualPages(Gigacage::Primitive, m_memory, m_mappedCapacity);
             break;
         }
     }
@@ -366,6 +419,9 @@ bool Memory::addressIsInActiveFastMemory(void* address)
 
 Expected<PageCount, Memory::GrowFailReason> Memory::grow(PageCount delta)
 {
+    // An unshared memory's callbacks may run the collector, which may destroy instances, so only
+    // shared memories, whose callbacks don't, can hold the lock here.
+    auto locker = holdLockIf(m_lock, isShared());
     const Wasm::PageCount oldPageCount = sizeInPages();
 
     if (!delta.isValid())
@@ -378,10 +434,8 @@ Expected<PageCount, Memory::GrowFailReason> Memory::grow(PageCount delta)
     auto success = [&] () {
         m_growSuccessCallback(GrowSuccessTag, oldPageCount, newPageCount);
         // Update cache for instance
-        for (auto& instance : m_instances) {
-            if (instance.get() != nullptr)
-                instance.get()->updateCachedMemory();
-        }
+        for (Instance* instance : m_instances)
+            instance->updateCachedMemory();
         return oldPageCount;
     };
 
@@ -409,6 +463,14 @@ Expected<PageCount, Memory::GrowFailReason> Memory::grow(PageCount delta)
     case MemoryMode::BoundsChecking: {
         RELEASE_ASSERT(maximum().bytes() != 0);
 
+        if (desiredSize <= m_mappedCapacity) {
+            // The pages were reserved, and zeroed, when the memory was created.
+            ASSERT(isShared());
+            m_size = desiredSize;
+            return success();
+        }
+        RELEASE_ASSERT(!isShared());
+
         void* newMemory = Gigacage::tryAllocateZeroedVirtualPages(Gigacage::Primitive, desiredSize);
         if (!newMemory)
             return makeUnexpected(GrowFailReason::OutOfMemory);
@@ -442,14 +504,14 @@ Expected<PageCount, Memory::GrowFailReason> Memory::grow(PageCount delta)
 
 void Memory::registerInstance(Instance* instance)
 {
-    size_t count = m_instances.size();
-    for (size_t index = 0; index < count; index++) {
-        if (m_instances.at(index).get() == nullptr) {
-            m_instances.at(index) = makeWeakPtr(*instance);
-            return;
-        }
-    }
-    m_instances.append(makeWeakPtr(*instance));
+    auto locker = holdLockIf(m_lock, isShared());
+    m_instances.append(instance);
+}
+
+void Memory::unregisterInstance(Instance* instance)
+{
+    auto locker = holdLockIf(m_lock, isShared());
+    m_instances.removeFirst(instance);
 }
 
 void Memory::dump(PrintStream& out) const
@@ -32,10 +32,10 @@
 
 #include <wtf/Expected.h>
 #include <wtf/Function.h>
-#include <wtf/RefCounted.h>
+#include <wtf/Lock.h>
 #include <wtf/RefPtr.h>
+#include <wtf/ThreadSafeRefCounted.h>
 #include <wtf/Vector.h>
-#include <wtf/WeakPtr.h>
 
 namespace WTF {
 class PrintStream;
@@ -47,7 +47,7 @@ namespace Wasm {
 
 class Instance;
 
-class Memory : public RefCounted<Memory> {
+class Memory : public ThreadSafeRefCounted<Memory> {
     WTF_MAKE_NONCOPYABLE(Memory);
     WTF_MAKE_FAST_ALLOCATED;
 public:
@@ -60,7 +60,7 @@ public:
     enum GrowSuccess { GrowSuccessTag };
 
     static RefPtr<Memory> create();
-    static RefPtr<Memory> create(PageCount initial, PageCount maximum, WTF::Function<void(NotifyPressure)>&& notifyMemoryPressure, WTF::Function<void(SyncTryToReclaim)>&& syncTryToReclaimMemory, WTF::Function<void(GrowSuccess, PageCount, PageCount)>&& growSuccessCallback);
+    static RefPtr<Memory> create(PageCount initial, PageCount maximum, MemorySharingMode, WTF::Function<void(NotifyPressure)>&& notifyMemoryPressure, WTF::Function<void(SyncTryToReclaim)>&& syncTryToReclaimMemory, WTF::Function<void(GrowSuccess, PageCount, PageCount)>&& growSuccessCallback);
 
     ~Memory();
 
@@ -76,6 +76,8 @@ public:
     PageCount maximum() const { return m_maximum; }
 
     MemoryMode mode() const { return m_mode; }
+    MemorySharingMode sharingMode() const { return m_sharingMode; }
+    bool isShared() const { return m_sharingMode == MemorySharingMode::Shared; }
 
     enum class GrowFailReason {
         InvalidDelta,
@@ -85,6 +87,7 @@ public:
     };
     Expected<PageCount, GrowFailReason> grow(PageCount);
     void registerInstance(Instance*);
+    void unregisterInstance(Instance*);
 
     void check() {  ASSERT(!deletionHasBegun()); }
 
@@ -93,8 +96,8 @@ public:
 
 private:
     Memory();
-    Memory(void* memory, PageCount initial, PageCount maximum, size_t mappedCapacity, MemoryMode, WTF::Function<void(NotifyPressure)>&& notifyMemoryPressure, WTF::Function<void(SyncTryToReclaim)>&& syncTryToReclaimMemory, WTF::Function<void(GrowSuccess, PageCount, PageCount)>&& growSuccessCallback);
-    Memory(PageCount initial, PageCount maximum, WTF::Function<void(NotifyPressure)>&& notifyMemoryPressure, WTF::Function<void(SyncTryToReclaim)>&& syncTryToReclaimMemory, WTF::Function<void(GrowSuccess, PageCount, PageCount)>&& growSuccessCallback);
+    Memory(void* memory, PageCount initial, PageCount maximum, size_t mappedCapacity, MemoryMode, MemorySharingMode, WTF::Function<void(NotifyPressure)>&& notifyMemoryPressure, WTF::Function<void(SyncTryToReclaim)>&& syncTryToReclaimMemory, WTF::Function<void(GrowSuccess, PageCount, PageCount)>&& growSuccessCallback);
+    Memory(PageCount initial, PageCount maximum, MemorySharingMode, WTF::Function<void(NotifyPressure)>&& notifyMemoryPressure, WTF::Function<void(SyncTryToReclaim)>&& syncTryToReclaimMemory, WTF::Function<void(GrowSuccess, PageCount, PageCount)>&& growSuccessCallback);
 
     void* m_memory { nullptr };
     size_t m_size { 0 };
@@ -102,10 +105,15 @@ private:
     PageCount m_maximum;
     size_t m_mappedCapacity { 0 };
     MemoryMode m_mode { MemoryMode::BoundsChecking };
+    MemorySharingMode m_sharingMode { MemorySharingMode::Default };
     WTF::Function<void(NotifyPressure)> m_notifyMemoryPressure;
     WTF::Function<void(SyncTryToReclaim)> m_syncTryToReclaimMemory;
     WTF::Function<void(GrowSuccess, PageCount, PageCount)> m_growSuccessCallback;
-    Vector<WeakPtr<Instance>> m_instances;
+    // Agents on other threads may grow a shared memory, or create and destroy instances of it, so
+    // for shared memories this lock guards growing and m_instances. A shared memory never moves,
+    // so an instance running on another thread only ever sees its cached size lag behind.
+    Lock m_lock;
+    Vector<Instance*> m_instances;
 };
 
 } } // namespace JSC::Wasm
@@ -40,6 +40,11 @@ enum class MemoryMode : uint8_t {
 static constexpr size_t NumberOfMemoryModes = 2;
 JS_EXPORT_PRIVATE const char* makeString(MemoryMode);
 
+enum class MemorySharingMode : uint8_t {
+    Default,
+    Shared,
+};
+
 } } // namespace JSC::Wasm
 
 #endif // ENABLE(WEBASSEMBLY)
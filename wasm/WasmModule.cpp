@@ -31,9 +31,84 @@
 #include "WasmBBQPlanInlines.h"
 #include "WasmModuleInformation.h"
 #include "WasmWorklist.h"
+#include <wtf/Deque.h>
+#include <wtf/HashMap.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/SHA1.h>
+#include <wtf/text/StringHash.h>
 
 namespace JSC { namespace Wasm {
 
+// Modules with identical bytes produce identical code, and a Module's CodeBlocks can be shared by
+// every instance in the process, so repeated compiles of the same bytes can reuse the first one.
+// The cache keeps the most recently added webAssemblyModuleCacheSize modules alive. It lives only
+// in memory: nothing is written to disk, so only compiling the same bytes again in the same process
+// benefits, and every new process still compiles its modules from scratch. VM::deleteAllCode()
+// empties it, so it is dropped on memory pressure along with the rest of the compiled code.
+class ModuleCache {
+public:
+    static String keyFor(const Vector<uint8_t>& source)
+    {
+        if (!Options::useWebAssemblyModuleCache())
+            return String();
+        SHA1 sha1;
+        sha1.addBytes(source);
+        return String(sha1.computeHexDigest().data());
+    }
+
+    static RefPtr<Module> get(const String& key)
+    {
+        if (key.isNull())
+            return nullptr;
+        auto locker = holdLock(lock());
+        return map().get(key);
+    }
+
+    static void add(const String& key, Module& module)
+    {
+        if (key.isNull())
+            return;
+        auto locker = holdLock(lock());
+        // The map is shared by every thread, so it must not share StringImpls with callers.
+        String isolatedKey = key.isolatedCopy();
+        if (!map().add(isolatedKey, &module).isNewEntry)
+            return;
+        order().append(isolatedKey);
+        while (order().size() > Options::webAssemblyModuleCacheSize())
+            map().remove(order().takeFirst());
+    }
+
+    static void clear()
+    {
+        HashMap<String, RefPtr<Module>> modules;
+        {
+            auto locker = holdLock(lock());
+            // Destroy the modules after dropping the lock.
+            modules = WTFMove(map());
+            order().clear();
+        }
+    }
+
+private:
+    static Lock& lock()
+    {
+        static Lock lock;
+        return lock;
+    }
+
+    static HashMap<String, RefPtr<Module>>& map()
+    {
+        static NeverDestroyed<HashMap<String, RefPtr<Module>>> map;
+        return map;
+    }
+
+    static Deque<String>& order()
+    {
+        static NeverDestroyed<Deque<String>> order;
+        return order;
+    }
+};
+
 Module::Module(Ref<ModuleInformation>&& moduleInformation)
     : m_moduleInformation(WTFMove(moduleInformation))
 {
@@ -41,6 +116,11 @@ Module::Module(Ref<ModuleInformation>&& moduleInformation)
 
 Module::~Module() { }
 
+void Module::clearCache()
+{
+    ModuleCache::clear();
+}
+
 Wasm::SignatureIndex Module::signatureIndexFromFunctionIndexSpace(unsigned functionIndexSpace) const
 {
     return m_moduleInformation->signatureIndexFromFunctionIndexSpace(functionIndexSpace);
@@ -64,13 +144,34 @@ static Plan::CompletionTask makeValidationCallback(Module::AsyncValidationCallba
 
 Module::ValidationResult Module::validateSync(Context* context, Vector<uint8_t>&& source)
 {
+    String cacheKey = ModuleCache::keyFor(source);
+    if (RefPtr<Module> module = ModuleCache::get(cacheKey))
+        return Module::ValidationResult(WTFMove(module));
+
     Ref<BBQPlan> plan = adoptRef(*new BBQPlan(context, WTFMove(source), BBQPlan::Validation, Plan::dontFinalize(), nullptr, nullptr));
     plan->parseAndValidateModule();
-    return makeValidationResult(plan.get());
+    auto result = makeValidationResult(plan.get());
+    if (result)
+        ModuleCache::add(cacheKey, *result.value());
+    return result;
 }
 
 void Module::validateAsync(Context* context, Vector<uint8_t>&& source, Module::AsyncValidationCallback&& callback)
 {
+    String cacheKey = ModuleCache::keyFor(source);
+    if (RefPtr<Module> module = ModuleCache::get(cacheKey)) {
+        callback->run(Module::ValidationResult(WTFMove(module)));
+        return;
+    }
+
+    if (!cacheKey.isNull()) {
+        callback = createSharedTask<CallbackType>([cacheKey = cacheKey.isolatedCopy(), callback = WTFMove(callback)] (ValidationResult&& result) {
+            if (result)
+                ModuleCache::add(cacheKey, *result.value());
+            callback->run(WTFMove(result));
+        });
+    }
+
     Ref<Plan> plan = adoptRef(*new BBQPlan(context, WTFMove(source), BBQPlan::Validation, makeValidationCallback(WTFMove(callback)), nullptr, nullptr));
     Wasm::ensureWorklist().enqueue(WTFMove(plan));
 }
@@ -80,6 +181,13 @@ Ref<CodeBlock> Module::getOrCreateCodeBlock(Context* context, MemoryMode mode, C
     RefPtr<CodeBlock> codeBlock;
     auto locker = holdLock(m_lock);
     codeBlock = m_codeBlocks[static_cast<uint8_t>(mode)];
+    // Bounds checking code is safe to run against any memory, so a fast memory can use it rather
+    // than wait for a second compile of the module.
+    if (!codeBlock && mode == MemoryMode::Signaling && Options::shareWebAssemblyCodeAcrossMemoryModes()) {
+        RefPtr<CodeBlock> boundsCheckingCodeBlock = m_codeBlocks[static_cast<uint8_t>(MemoryMode::BoundsChecking)];
+        if (boundsCheckingCodeBlock && boundsCheckingCodeBlock->runnable())
+            return boundsCheckingCodeBlock.releaseNonNull();
+    }
     // If a previous attempt at a compile errored out, let's try again.
     // Compilations from valid modules can fail because OOM and cancellation.
     // It's worth retrying.
@@ -92,6 +200,14 @@ Ref<CodeBlock> Module::getOrCreateCodeBlock(Context* context, MemoryMode mode, C
     return codeBlock.releaseNonNull();
 }
 
+void Module::adoptCodeBlock(Ref<CodeBlock>&& codeBlock)
+{
+    auto locker = holdLock(m_lock);
+    RefPtr<CodeBlock>& slot = m_codeBlocks[static_cast<uint8_t>(codeBlock->mode())];
+    ASSERT(!slot);
+    slot = WTFMove(codeBlock);
+}
+
 Ref<CodeBlock> Module::compileSync(Context* context, MemoryMode mode, CreateEmbedderWrapper&& createEmbedderWrapper, ThrowWasmException throwWasmException)
 {
     Ref<CodeBlock> codeBlock = getOrCreateCodeBlock(context, mode, WTFMove(createEmbedderWrapper), throwWasmException);
@@ -52,6 +52,9 @@ public:
     static ValidationResult validateSync(Context*, Vector<uint8_t>&& source);
     static void validateAsync(Context*, Vector<uint8_t>&& source, Module::AsyncValidationCallback&&);
 
+    // Drops every module kept alive by useWebAssemblyModuleCache.
+    JS_EXPORT_PRIVATE static void clearCache();
+
     static Ref<Module> create(Ref<ModuleInformation>&& moduleInformation)
     {
         return adoptRef(*new Module(WTFMove(moduleInformation)));
@@ -63,6 +66,10 @@ public:
     Ref<CodeBlock> compileSync(Context*, MemoryMode, CreateEmbedderWrapper&&, ThrowWasmException);
     void compileAsync(Context*, MemoryMode, CodeBlock::AsyncCompilationCallback&&, CreateEmbedderWrapper&&, ThrowWasmException);
 
+    // Gives a fresh module a CodeBlock whose compile started before the module existed, e.g. one
+    // that was compiled while the module was streamed in.
+    void adoptCodeBlock(Ref<CodeBlock>&&);
+
     JS_EXPORT_PRIVATE ~Module();
 
     CodeBlock* codeBlockFor(MemoryMode mode) { return m_codeBlocks[static_cast<uint8_t>(mode)].get(); }
@@ -32,6 +32,7 @@
 #include "B3OpaqueByproducts.h"
 #include "JSCInlines.h"
 #include "LinkBuffer.h"
+#include "ProbeContext.h"
 #include "WasmB3IRGenerator.h"
 #include "WasmCallee.h"
 #include "WasmContext.h"
@@ -53,11 +54,12 @@ namespace WasmOMGPlanInternal {
 static const bool verbose = false;
 }
 
-OMGPlan::OMGPlan(Context* context, Ref<Module>&& module, uint32_t functionIndex, MemoryMode mode, CompletionTask&& task)
+OMGPlan::OMGPlan(Context* context, Ref<Module>&& module, uint32_t functionIndex, MemoryMode mode, CompletionTask&& task, std::optional<uint32_t> loopIndexForOSREntry)
     : Base(context, makeRef(const_cast<ModuleInformation&>(module->moduleInformation())), WTFMove(task))
     , m_module(WTFMove(module))
     , m_codeBlock(*m_module->codeBlockFor(mode))
     , m_functionIndex(functionIndex)
+    , m_loopIndexForOSREntry(loopIndexForOSREntry)
 {
     setMode(mode);
     ASSERT(m_codeBlock->runnable());
@@ -81,9 +83,18 @@ void OMGPlan::work(CompilationEffort)
     const Signature& signature = SignatureInformation::get(signatureIndex);
     ASSERT(validateFunction(functionStart, functionLength, signature, m_moduleInformation.get()));
 
+    // OMG code keeps counting calls in the same profile as the BBQ code it replaces. OSR entry code
+    // is not entered by calls, so it neither counts them nor reports its compile.
+    FunctionProfile* profile = m_codeBlock->m_functionProfiles.isEmpty() || m_loopIndexForOSREntry ? nullptr : &m_codeBlock->m_functionProfiles[m_functionIndex];
+
+    MonotonicTime startTime;
+    if (WasmOMGPlanInternal::verbose || Options::reportCompileTimes() || profile)
+        startTime = MonotonicTime::now();
+
     Vector<UnlinkedWasmToWasmCall> unlinkedCalls;
     CompilationContext context;
-    auto parseAndCompileResult = parseAndCompile(context, functionStart, functionLength, signature, unlinkedCalls, m_moduleInformation.get(), m_mode, CompilationMode::OMGMode, m_functionIndex);
+    CompilationMode compilationMode = m_loopIndexForOSREntry ? CompilationMode::OMGForOSREntryMode : CompilationMode::OMGMode;
+    auto parseAndCompileResult = parseAndCompile(context, functionStart, functionLength, signature, unlinkedCalls, m_moduleInformation.get(), m_mode, compilationMode, m_functionIndex, nullptr, nullptr, profile ? &profile->callCount : nullptr, m_loopIndexForOSREntry.value_or(UINT32_MAX));
 
     if (UNLIKELY(!parseAndCompileResult)) {
         fail(holdLock(m_lock), makeString(parseAndCompileResult.error(), "when trying to tier up ", String::number(m_functionIndex)));
@@ -97,12 +108,34 @@ void OMGPlan::work(CompilationEffort)
         return;
     }
 
-    omgEntrypoint.compilation = std::make_unique<B3::Compilation>(
-        FINALIZE_CODE(linkBuffer, B3CompilationPtrTag, "WebAssembly OMG function[%i] %s", m_functionIndex, signature.toString().ascii().data()),
-        WTFMove(context.wasmEntrypointByproducts));
+    if (profile) {
+        profile->omgCompileTime = MonotonicTime::now() - startTime;
+        profile->omgCodeSize = linkBuffer.size();
+    }
+
+    if (m_loopIndexForOSREntry) {
+        omgEntrypoint.compilation = std::make_unique<B3::Compilation>(
+            FINALIZE_CODE(linkBuffer, B3CompilationPtrTag, "WebAssembly OMG OSR entry function[%i] loop[%u] %s", m_functionIndex, *m_loopIndexForOSREntry, signature.toString().ascii().data()),
+            WTFMove(context.wasmEntrypointByproducts));
+    } else {
+        omgEntrypoint.compilation = std::make_unique<B3::Compilation>(
+            FINALIZE_CODE(linkBuffer, B3CompilationPtrTag, "WebAssembly OMG function[%i] %s", m_functionIndex, signature.toString().ascii().data()),
+            WTFMove(context.wasmEntrypointByproducts));
+    }
 
     omgEntrypoint.calleeSaveRegisters = WTFMove(parseAndCompileResult.value()->entrypoint.calleeSaveRegisters);
 
+    if (WasmOMGPlanInternal::verbose || Options::reportCompileTimes()) {
+        Seconds compileTime = MonotonicTime::now() - startTime;
+        dataLogLn("Took ", compileTime.milliseconds(), " ms to OMG compile function[", m_functionIndex, "] (", functionLength, " bytes, ",
+            static_cast<double>(functionLength) / MB / compileTime.seconds(), " MB/s)");
+    }
+
+    if (m_loopIndexForOSREntry) {
+        completeOSREntry(WTFMove(omgEntrypoint), *parseAndCompileResult.value(), WTFMove(unlinkedCalls), functionIndexSpace);
+        return;
+    }
+
     MacroAssemblerCodePtr<WasmEntryPtrTag> entrypoint;
     {
         ASSERT(m_codeBlock.ptr() == m_module->codeBlockFor(mode()));
@@ -164,10 +197,115 @@ void OMGPlan::work(CompilationEffort)
     complete(holdLock(m_lock));
 }
 
+void OMGPlan::completeOSREntry(Entrypoint&& osrEntrypoint, InternalFunction& function, Vector<UnlinkedWasmToWasmCall>&& unlinkedCalls, uint32_t functionIndexSpace)
+{
+    Ref<Callee> callee = Callee::create(WTFMove(osrEntrypoint), functionIndexSpace, m_moduleInformation->nameSection->get(functionIndexSpace));
+    MacroAssembler::repatchPointer(function.calleeMoveLocation, CalleeBits::boxWasm(callee.ptr()));
+
+    {
+        LockHolder holder(m_codeBlock->m_lock);
+        for (auto& call : unlinkedCalls) {
+            MacroAssemblerCodePtr<WasmEntryPtrTag> entrypoint;
+            if (call.functionIndexSpace < m_module->moduleInformation().importFunctionCount())
+                entrypoint = m_codeBlock->m_wasmToWasmExitStubs[call.functionIndexSpace].code();
+            else
+                entrypoint = m_codeBlock->wasmEntrypointCalleeFromFunctionIndexSpace(call.functionIndexSpace).entrypoint().retagged<WasmEntryPtrTag>();
+
+            MacroAssembler::repatchNearCall(call.callLocation, CodeLocationLabel<WasmEntryPtrTag>(entrypoint));
+        }
+        // Later tier-ups of the callees repatch these calls too.
+        m_codeBlock->m_wasmToWasmCallsites[m_functionIndex].appendVector(unlinkedCalls);
+    }
+
+    resetInstructionCacheOnAllThreads();
+    WTF::storeStoreFence();
+
+    {
+        LockHolder holder(m_codeBlock->m_lock);
+        ASSERT(!m_codeBlock->m_osrEntryCallees[m_functionIndex]);
+        m_codeBlock->m_osrEntryCallees[m_functionIndex] = WTFMove(callee);
+    }
+
+    dataLogLnIf(WasmOMGPlanInternal::verbose, "Finished OSR entry compile of function ", m_functionIndex, " at loop ", *m_loopIndexForOSREntry);
+    complete(holdLock(m_lock));
+}
+
+void OMGPlan::triggerOSREntryNow(Probe::Context& context)
+{
+    OSREntryData& osrEntryData = *context.arg<OSREntryData*>();
+    uint32_t functionIndex = osrEntryData.functionIndex();
+    uint32_t loopIndex = osrEntryData.loopIndex();
+    Instance* instance = context.gpr<Instance*>(osrEntryData.instanceGPR());
+    Wasm::CodeBlock& codeBlock = *instance->codeBlock();
+    TierUpCount& tierUp = codeBlock.tierUpCount(functionIndex);
+
+    // This check replaces the loop's regular tier-up check, so calls to the function need their OMG code too.
+    runForIndex(instance, functionIndex);
+
+    if (tierUp.shouldStartOSREntryCompile(loopIndex)) {
+        Ref<Plan> plan = adoptRef(*new OMGPlan(instance->context(), Ref<Wasm::Module>(instance->module()), functionIndex, codeBlock.mode(), Plan::dontFinalize(), loopIndex));
+        ensureWorklist().enqueue(plan.copyRef());
+        if (UNLIKELY(!Options::useConcurrentJIT()))
+            plan->waitForCompletion();
+    }
+
+    // The OSR entry code only enters at the first loop that asked for it.
+    if (tierUp.osrEntryLoopIndex() != loopIndex)
+        return;
+
+    RefPtr<Callee> osrEntryCallee = codeBlock.osrEntryCallee(functionIndex);
+    if (!osrEntryCallee) {
+        tierUp.checkOSREntrySoon();
+        return;
+    }
+
+    const Vector<OSREntryValue>& values = osrEntryData.values();
+    uint64_t* buffer = instance->osrEntryScratchBuffer(values.size());
+    for (unsigned i = 0; i < values.size(); ++i) {
+        const OSREntryValue& value = values[i];
+        if (value.isGPR())
+            buffer[i] = context.gpr(value.gpr());
+        else if (value.isFPR())
+            buffer[i] = bitwise_cast<uint64_t>(context.fpr(value.fpr()));
+        else if (value.isConstant())
+            buffer[i] = value.value();
+        else if (value.isStack())
+            buffer[i] = *bitwise_cast<uint64_t*>(context.fp<uint8_t*>() + value.offsetFromFP());
+        else
+            RELEASE_ASSERT_NOT_REACHED();
+        dataLogLnIf(WasmOMGPlanInternal::verbose, "OSR entry value ", i, " of type ", value.type(), " at ", static_cast<const B3::ValueRep&>(value), ": ", buffer[i]);
+    }
+
+    // Leave the BBQ frame the way its epilogue would, so that the OSR entry code starts as though
+    // the BBQ code's caller had called it.
+    for (const RegisterAtOffset& entry : osrEntryData.calleeSaveRegisters()) {
+        uint64_t savedValue = *bitwise_cast<uint64_t*>(context.fp<uint8_t*>() + entry.offset());
+        if (entry.reg().isGPR())
+            context.gpr(entry.reg().gpr()) = savedValue;
+        else
+            context.fpr(entry.reg().fpr()) = bitwise_cast<double>(savedValue);
+    }
+
+    CallerFrameAndPC* frame = context.fp<CallerFrameAndPC*>();
+#if CPU(X86_64)
+    context.sp() = &frame->pc;
+#elif CPU(ARM64)
+    context.gpr(ARM64Registers::lr) = bitwise_cast<uintptr_t>(frame->pc);
+    context.sp() = frame + 1;
+#else
+#error "OSR entry into WebAssembly OMG code is only implemented on X86_64 and ARM64"
+#endif
+    context.fp() = frame->callerFrame;
+
+    context.gpr(GPRInfo::argumentGPR0) = bitwise_cast<uintptr_t>(buffer);
+    context.pc() = osrEntryCallee->entrypoint().executableAddress();
+    dataLogLnIf(WasmOMGPlanInternal::verbose, "OSR entering function ", functionIndex, " at loop ", loopIndex);
+}
+
 void OMGPlan::runForIndex(Instance* instance, uint32_t functionIndex)
 {
     Wasm::CodeBlock& codeBlock = *instance->codeBlock();
-    ASSERT(instance->memory()->mode() == codeBlock.mode());
+    ASSERT(codeBlock.isSafeToRun(instance->memory()->mode()));
 
     if (codeBlock.tierUpCount(functionIndex).shouldStartTierUp()) {
         Ref<Plan> plan = adoptRef(*new OMGPlan(instance->context(), Ref<Wasm::Module>(instance->module()), functionIndex, codeBlock.mode(), Plan::dontFinalize()));
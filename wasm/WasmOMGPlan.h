@@ -35,6 +35,10 @@ namespace JSC {
 
 class CallLinkInfo;
 
+namespace Probe {
+class Context;
+}
+
 namespace Wasm {
 
 class OMGPlan final : public Plan {
@@ -47,12 +51,17 @@ public:
 
     static void runForIndex(Instance*, uint32_t functionIndex);
 
+    // Probe function of BBQ loop tier-up checks. Its argument is the check's OSREntryData.
+    static void triggerOSREntryNow(Probe::Context&);
+
 private:
     // For some reason friendship doesn't extend to parent classes...
     using Base::m_lock;
 
     // Note: CompletionTask should not hold a reference to the Plan otherwise there will be a reference cycle.
-    OMGPlan(Context*, Ref<Module>&&, uint32_t functionIndex, MemoryMode, CompletionTask&&);
+    OMGPlan(Context*, Ref<Module>&&, uint32_t functionIndex, MemoryMode, CompletionTask&&, std::optional<uint32_t> loopIndexForOSREntry = std::nullopt);
+
+    void completeOSREntry(Entrypoint&&, InternalFunction&, Vector<UnlinkedWasmToWasmCall>&&, uint32_t functionIndexSpace);
 
     bool isComplete() const override { return m_completed; }
     void complete(const AbstractLocker& locker) override
@@ -65,6 +74,7 @@ private:
     Ref<CodeBlock> m_codeBlock;
     bool m_completed { false };
     uint32_t m_functionIndex;
+    std::optional<uint32_t> m_loopIndexForOSREntry;
 };
 
 } } // namespace JSC::Wasm
@@ -32,6 +32,10 @@ namespace JSC { namespace Wasm {
 
 void OpcodeOrigin::dump(PrintStream& out) const
 {
+    if (!isValidOpType(static_cast<uint8_t>(opcode()))) {
+        out.print("{opcode: ", static_cast<unsigned>(opcode()), " ", prefixedOpcode(), ", location: ", location(), "}");
+        return;
+    }
     out.print("{opcode: ", makeString(opcode()), ", location: ", location(), "}");
 }
 
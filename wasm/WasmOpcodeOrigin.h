@@ -37,14 +37,22 @@ class OpcodeOrigin {
 public:
     OpcodeOrigin() = default;
     OpcodeOrigin(OpType opcode, size_t offset)
+        : OpcodeOrigin(opcode, 0, offset)
+    {
+    }
+
+    // For an opcode behind a prefix byte, opcode is the prefix, which is not a valid OpType.
+    OpcodeOrigin(OpType opcode, uint32_t prefixedOpcode, size_t offset)
     {
         ASSERT(static_cast<uint32_t>(offset) == offset);
-        packedData = (static_cast<uint64_t>(opcode) << 32) | offset;
+        ASSERT(prefixedOpcode < (1u << 24));
+        packedData = (static_cast<uint64_t>(prefixedOpcode) << 40) | (static_cast<uint64_t>(opcode) << 32) | offset;
     }
 
     void dump(PrintStream&) const;
 
-    OpType opcode() const { return static_cast<OpType>(packedData >> 32); }
+    OpType opcode() const { return static_cast<OpType>(static_cast<uint8_t>(packedData >> 32)); }
+    uint32_t prefixedOpcode() const { return static_cast<uint32_t>(packedData >> 40); }
     size_t location() const { return static_cast<uint32_t>(packedData); }
 
 private:
@@ -29,10 +29,12 @@
 
 #include "B3Compilation.h"
 #include "B3Procedure.h"
+#include "WasmAtomicOpcodes.h"
 #include "WasmFormat.h"
 #include "WasmLimits.h"
 #include "WasmModuleInformation.h"
 #include "WasmOps.h"
+#include "WasmSIMDOpcodes.h"
 #include "WasmSections.h"
 #include <type_traits>
 #include <wtf/Expected.h>
@@ -81,6 +83,24 @@ protected:
     bool WARN_UNUSED_RETURN parseValueType(Type&);
     bool WARN_UNUSED_RETURN parseExternalKind(ExternalKind&);
 
+    // Opcodes following the 0xfd prefix are SIMDOpTypes. v128 values can't cross function,
+    // global or import boundaries yet, because the calling convention has no way to pass them.
+    static constexpr uint8_t simdOpcodePrefix = 0xfd;
+    static constexpr uint8_t v128TypeEncoding = 0x7b;
+    bool atV128Type() const { return m_offset < length() && source()[m_offset] == v128TypeEncoding; }
+
+    // Opcodes following the 0xfc prefix. Of the bulk memory proposal, only memory.copy and
+    // memory.fill are supported.
+    static constexpr uint8_t miscOpcodePrefix = 0xfc;
+    enum class MiscOpType : uint32_t {
+        MemoryCopy = 0x0a,
+        MemoryFill = 0x0b,
+    };
+
+    // Opcodes following the 0xfe prefix are AtomicOpTypes, from the threads proposal. They are only
+    // valid when Options::useWebAssemblyThreads() is set.
+    static constexpr uint8_t atomicOpcodePrefix = 0xfe;
+
     const uint8_t* source() const { return m_source; }
     size_t length() const { return m_sourceLength; }
 
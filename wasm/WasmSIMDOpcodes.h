@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) 2018 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "WasmOps.h"
+#include <cstdint>
+
+namespace JSC { namespace Wasm {
+
+// The bits of a v128 value. Lane 0 is at the lowest address, as in memory.
+union v128_t {
+    uint8_t u8x16[16];
+    uint64_t u64x2[2];
+};
+
+// How an instruction interprets the 128 bits of its v128 operands. V128 is for instructions that
+// don't care about lanes.
+enum class SIMDLane : uint8_t {
+    V128,
+    I8x16,
+    I16x8,
+    I32x4,
+    I64x2,
+    F32x4,
+    F64x2,
+};
+
+// The immediates and the stack signature of an instruction follow from its category:
+//   Load:        memarg; i32 -> v128
+//   Store:       memarg; i32 v128 -> ()
+//   Const:       16 bytes; () -> v128
+//   Shuffle:     16 lane indices; v128 v128 -> v128
+//   Splat:       lane scalar -> v128
+//   ExtractLane: lane index; v128 -> lane scalar
+//   ReplaceLane: lane index; v128 lane scalar -> v128
+//   Unary:       v128 -> v128
+//   Binary:      v128 v128 -> v128
+//   Shift:       v128 i32 -> v128
+//   BitSelect:   v128 v128 v128 -> v128
+//   Reduce:      v128 -> i32
+enum class SIMDOpCategory : uint8_t {
+    Load,
+    Store,
+    Const,
+    Shuffle,
+    Splat,
+    ExtractLane,
+    ReplaceLane,
+    Unary,
+    Binary,
+    Shift,
+    BitSelect,
+    Reduce,
+};
+
+// The supported opcodes following the 0xfd prefix, numbered as in the final SIMD proposal.
+#define FOR_EACH_WASM_SIMD_OP(macro) \
+    macro(V128Load,              0x00, Load,        V128) \
+    macro(V128Store,             0x0b, Store,       V128) \
+    macro(V128Const,             0x0c, Const,       V128) \
+    macro(I8x16Shuffle,          0x0d, Shuffle,     I8x16) \
+    macro(I8x16Swizzle,          0x0e, Binary,      I8x16) \
+    macro(I8x16Splat,            0x0f, Splat,       I8x16) \
+    macro(I16x8Splat,            0x10, Splat,       I16x8) \
+    macro(I32x4Splat,            0x11, Splat,       I32x4) \
+    macro(I64x2Splat,            0x12, Splat,       I64x2) \
+    macro(F32x4Splat,            0x13, Splat,       F32x4) \
+    macro(F64x2Splat,            0x14, Splat,       F64x2) \
+    macro(I8x16ExtractLaneS,     0x15, ExtractLane, I8x16) \
+    macro(I8x16ExtractLaneU,     0x16, ExtractLane, I8x16) \
+    macro(I8x16ReplaceLane,      0x17, ReplaceLane, I8x16) \
+    macro(I16x8ExtractLaneS,     0x18, ExtractLane, I16x8) \
+    macro(I16x8ExtractLaneU,     0x19, ExtractLane, I16x8) \
+    macro(I16x8ReplaceLane,      0x1a, ReplaceLane, I16x8) \
+    macro(I32x4ExtractLane,      0x1b, ExtractLane, I32x4) \
+    macro(I32x4ReplaceLane,      0x1c, ReplaceLane, I32x4) \
+    macro(I64x2ExtractLane,      0x1d, ExtractLane, I64x2) \
+    macro(I64x2ReplaceLane,      0x1e, ReplaceLane, I64x2) \
+    macro(F32x4ExtractLane,      0x1f, ExtractLane, F32x4) \
+    macro(F32x4ReplaceLane,      0x20, ReplaceLane, F32x4) \
+    macro(F64x2ExtractLane,      0x21, ExtractLane, F64x2) \
+    macro(F64x2ReplaceLane,      0x22, ReplaceLane, F64x2) \
+    macro(I8x16Eq,               0x23, Binary,      I8x16) \
+    macro(I8x16Ne,               0x24, Binary,      I8x16) \
+    macro(I8x16LtS,              0x25, Binary,      I8x16) \
+    macro(I8x16LtU,              0x26, Binary,      I8x16) \
+    macro(I8x16GtS,              0x27, Binary,      I8x16) \
+    macro(I8x16GtU,              0x28, Binary,      I8x16) \
+    macro(I8x16LeS,              0x29, Binary,      I8x16) \
+    macro(I8x16LeU,              0x2a, Binary,      I8x16) \
+    macro(I8x16GeS,              0x2b, Binary,      I8x16) \
+    macro(I8x16GeU,              0x2c, Binary,      I8x16) \
+    macro(I16x8Eq,               0x2d, Binary,      I16x8) \
+    macro(I16x8Ne,               0x2e, Binary,      I16x8) \
+    macro(I16x8LtS,              0x2f, Binary,      I16x8) \
+    macro(I16x8LtU,              0x30, Binary,      I16x8) \
+    macro(I16x8GtS,              0x31, Binary,      I16x8) \
+    macro(I16x8GtU,              0x32, Binary,      I16x8) \
+    macro(I16x8LeS,              0x33, Binary,      I16x8) \
+    macro(I16x8LeU,              0x34, Binary,      I16x8) \
+    macro(I16x8GeS,              0x35, Binary,      I16x8) \
+    macro(I16x8GeU,              0x36, Binary,      I16x8) \
+    macro(I32x4Eq,               0x37, Binary,      I32x4) \
+    macro(I32x4Ne,               0x38, Binary,      I32x4) \
+    macro(I32x4LtS,              0x39, Binary,      I32x4) \
+    macro(I32x4LtU,              0x3a, Binary,      I32x4) \
+    macro(I32x4GtS,              0x3b, Binary,      I32x4) \
+    macro(I32x4GtU,              0x3c, Binary,      I32x4) \
+    macro(I32x4LeS,              0x3d, Binary,      I32x4) \
+    macro(I32x4LeU,              0x3e, Binary,      I32x4) \
+    macro(I32x4GeS,              0x3f, Binary,      I32x4) \
+    macro(I32x4GeU,              0x40, Binary,      I32x4) \
+    macro(F32x4Eq,               0x41, Binary,      F32x4) \
+    macro(F32x4Ne,               0x42, Binary,      F32x4) \
+    macro(F32x4Lt,               0x43, Binary,      F32x4) \
+    macro(F32x4Gt,               0x44, Binary,      F32x4) \
+    macro(F32x4Le,               0x45, Binary,      F32x4) \
+    macro(F32x4Ge,               0x46, Binary,      F32x4) \
+    macro(F64x2Eq,               0x47, Binary,      F64x2) \
+    macro(F64x2Ne,               0x48, Binary,      F64x2) \
+    macro(F64x2Lt,               0x49, Binary,      F64x2) \
+    macro(F64x2Gt,               0x4a, Binary,      F64x2) \
+    macro(F64x2Le,               0x4b, Binary,      F64x2) \
+    macro(F64x2Ge,               0x4c, Binary,      F64x2) \
+    macro(V128Not,               0x4d, Unary,       V128) \
+    macro(V128And,               0x4e, Binary,      V128) \
+    macro(V128AndNot,            0x4f, Binary,      V128) \
+    macro(V128Or,                0x50, Binary,      V128) \
+    macro(V128Xor,               0x51, Binary,      V128) \
+    macro(V128Bitselect,         0x52, BitSelect,   V128) \
+    macro(V128AnyTrue,           0x53, Reduce,      V128) \
+    macro(I8x16Abs,              0x60, Unary,       I8x16) \
+    macro(I8x16Neg,              0x61, Unary,       I8x16) \
+    macro(I8x16AllTrue,          0x63, Reduce,      I8x16) \
+    macro(I8x16Bitmask,          0x64, Reduce,      I8x16) \
+    macro(I8x16Shl,              0x6b, Shift,       I8x16) \
+    macro(I8x16ShrS,             0x6c, Shift,       I8x16) \
+    macro(I8x16ShrU,             0x6d, Shift,       I8x16) \
+    macro(I8x16Add,              0x6e, Binary,      I8x16) \
+    macro(I8x16AddSatS,          0x6f, Binary,      I8x16) \
+    macro(I8x16AddSatU,          0x70, Binary,      I8x16) \
+    macro(I8x16Sub,              0x71, Binary,      I8x16) \
+    macro(I8x16SubSatS,          0x72, Binary,      I8x16) \
+    macro(I8x16SubSatU,          0x73, Binary,      I8x16) \
+    macro(I8x16MinS,             0x76, Binary,      I8x16) \
+    macro(I8x16MinU,             0x77, Binary,      I8x16) \
+    macro(I8x16MaxS,             0x78, Binary,      I8x16) \
+    macro(I8x16MaxU,             0x79, Binary,      I8x16) \
+    macro(I8x16AvgrU,            0x7b, Binary,      I8x16) \
+    macro(I16x8Abs,              0x80, Unary,       I16x8) \
+    macro(I16x8Neg,              0x81, Unary,       I16x8) \
+    macro(I16x8AllTrue,          0x83, Reduce,      I16x8) \
+    macro(I16x8Bitmask,          0x84, Reduce,      I16x8) \
+    macro(I16x8Shl,              0x8b, Shift,       I16x8) \
+    macro(I16x8ShrS,             0x8c, Shift,       I16x8) \
+    macro(I16x8ShrU,             0x8d, Shift,       I16x8) \
+    macro(I16x8Add,              0x8e, Binary,      I16x8) \
+    macro(I16x8AddSatS,          0x8f, Binary,      I16x8) \
+    macro(I16x8AddSatU,          0x90, Binary,      I16x8) \
+    macro(I16x8Sub,              0x91, Binary,      I16x8) \
+    macro(I16x8SubSatS,          0x92, Binary,      I16x8) \
+    macro(I16x8SubSatU,          0x93, Binary,      I16x8) \
+    macro(I16x8Mul,              0x95, Binary,      I16x8) \
+    macro(I16x8MinS,             0x96, Binary,      I16x8) \
+    macro(I16x8MinU,             0x97, Binary,      I16x8) \
+    macro(I16x8MaxS,             0x98, Binary,      I16x8) \
+    macro(I16x8MaxU,             0x99, Binary,      I16x8) \
+    macro(I16x8AvgrU,            0x9b, Binary,      I16x8) \
+    macro(I32x4Abs,              0xa0, Unary,       I32x4) \
+    macro(I32x4Neg,              0xa1, Unary,       I32x4) \
+    macro(I32x4AllTrue,          0xa3, Reduce,      I32x4) \
+    macro(I32x4Bitmask,          0xa4, Reduce,      I32x4) \
+    macro(I32x4Shl,              0xab, Shift,       I32x4) \
+    macro(I32x4ShrS,             0xac, Shift,       I32x4) \
+    macro(I32x4ShrU,             0xad, Shift,       I32x4) \
+    macro(I32x4Add,              0xae, Binary,      I32x4) \
+    macro(I32x4Sub,              0xb1, Binary,      I32x4) \
+    macro(I32x4Mul,              0xb5, Binary,      I32x4) \
+    macro(I32x4MinS,             0xb6, Binary,      I32x4) \
+    macro(I32x4MinU,             0xb7, Binary,      I32x4) \
+    macro(I32x4MaxS,             0xb8, Binary,      I32x4) \
+    macro(I32x4MaxU,             0xb9, Binary,      I32x4) \
+    macro(I64x2Abs,              0xc0, Unary,       I64x2) \
+    macro(I64x2Neg,              0xc1, Unary,       I64x2) \
+    macro(I64x2AllTrue,          0xc3, Reduce,      I64x2) \
+    macro(I64x2Bitmask,          0xc4, Reduce,      I64x2) \
+    macro(I64x2Shl,              0xcb, Shift,       I64x2) \
+    macro(I64x2ShrS,             0xcc, Shift,       I64x2) \
+    macro(I64x2ShrU,             0xcd, Shift,       I64x2) \
+    macro(I64x2Add,              0xce, Binary,      I64x2) \
+    macro(I64x2Sub,              0xd1, Binary,      I64x2) \
+    macro(I64x2Mul,              0xd5, Binary,      I64x2) \
+    macro(I64x2Eq,               0xd6, Binary,      I64x2) \
+    macro(I64x2Ne,               0xd7, Binary,      I64x2) \
+    macro(I64x2LtS,              0xd8, Binary,      I64x2) \
+    macro(I64x2GtS,              0xd9, Binary,      I64x2) \
+    macro(I64x2LeS,              0xda, Binary,      I64x2) \
+    macro(I64x2GeS,              0xdb, Binary,      I64x2) \
+    macro(F32x4Abs,              0xe0, Unary,       F32x4) \
+    macro(F32x4Neg,              0xe1, Unary,       F32x4) \
+    macro(F32x4Sqrt,             0xe3, Unary,       F32x4) \
+    macro(F32x4Add,              0xe4, Binary,      F32x4) \
+    macro(F32x4Sub,              0xe5, Binary,      F32x4) \
+    macro(F32x4Mul,              0xe6, Binary,      F32x4) \
+    macro(F32x4Div,              0xe7, Binary,      F32x4) \
+    macro(F32x4Min,              0xe8, Binary,      F32x4) \
+    macro(F32x4Max,              0xe9, Binary,      F32x4) \
+    macro(F32x4Pmin,             0xea, Binary,      F32x4) \
+    macro(F32x4Pmax,             0xeb, Binary,      F32x4) \
+    macro(F64x2Abs,              0xec, Unary,       F64x2) \
+    macro(F64x2Neg,              0xed, Unary,       F64x2) \
+    macro(F64x2Sqrt,             0xef, Unary,       F64x2) \
+    macro(F64x2Add,              0xf0, Binary,      F64x2) \
+    macro(F64x2Sub,              0xf1, Binary,      F64x2) \
+    macro(F64x2Mul,              0xf2, Binary,      F64x2) \
+    macro(F64x2Div,              0xf3, Binary,      F64x2) \
+    macro(F64x2Min,              0xf4, Binary,      F64x2) \
+    macro(F64x2Max,              0xf5, Binary,      F64x2) \
+    macro(F64x2Pmin,             0xf6, Binary,      F64x2) \
+    macro(F64x2Pmax,             0xf7, Binary,      F64x2) \
+    macro(I32x4TruncSatF32x4S,   0xf8, Unary,       I32x4) \
+    macro(I32x4TruncSatF32x4U,   0xf9, Unary,       I32x4) \
+    macro(F32x4ConvertI32x4S,    0xfa, Unary,       F32x4) \
+    macro(F32x4ConvertI32x4U,    0xfb, Unary,       F32x4)
+
+#define CREATE_ENUM_VALUE(name, id, category, lane) name = id,
+enum class SIMDOpType : uint32_t {
+    FOR_EACH_WASM_SIMD_OP(CREATE_ENUM_VALUE)
+};
+#undef CREATE_ENUM_VALUE
+
+inline bool isValidSIMDOpType(uint32_t op)
+{
+    switch (op) {
+#define CREATE_CASE(name, id, category, lane) case id:
+    FOR_EACH_WASM_SIMD_OP(CREATE_CASE)
+#undef CREATE_CASE
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+inline SIMDOpCategory simdCategory(SIMDOpType op)
+{
+    switch (op) {
+#define CREATE_CASE(name, id, category, lane) case SIMDOpType::name: return SIMDOpCategory::category;
+    FOR_EACH_WASM_SIMD_OP(CREATE_CASE)
+#undef CREATE_CASE
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return SIMDOpCategory::Unary;
+}
+
+inline SIMDLane simdLane(SIMDOpType op)
+{
+    switch (op) {
+#define CREATE_CASE(name, id, category, lane) case SIMDOpType::name: return SIMDLane::lane;
+    FOR_EACH_WASM_SIMD_OP(CREATE_CASE)
+#undef CREATE_CASE
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return SIMDLane::V128;
+}
+
+inline const char* makeString(SIMDOpType op)
+{
+    switch (op) {
+#define CREATE_CASE(name, id, category, lane) case SIMDOpType::name: return #name;
+    FOR_EACH_WASM_SIMD_OP(CREATE_CASE)
+#undef CREATE_CASE
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return nullptr;
+}
+
+inline unsigned laneCount(SIMDLane lane)
+{
+    switch (lane) {
+    case SIMDLane::I8x16:
+    case SIMDLane::V128:
+        return 16;
+    case SIMDLane::I16x8:
+        return 8;
+    case SIMDLane::I32x4:
+    case SIMDLane::F32x4:
+        return 4;
+    case SIMDLane::I64x2:
+    case SIMDLane::F64x2:
+        return 2;
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return 0;
+}
+
+inline unsigned laneSizeInBytes(SIMDLane lane)
+{
+    return 16 / laneCount(lane);
+}
+
+inline bool isFloatingPointLane(SIMDLane lane)
+{
+    return lane == SIMDLane::F32x4 || lane == SIMDLane::F64x2;
+}
+
+// The wasm type that splat, extract_lane and replace_lane use for a lane. Lanes narrower than 32
+// bits are widened to i32.
+inline Type laneScalarType(SIMDLane lane)
+{
+    switch (lane) {
+    case SIMDLane::I8x16:
+    case SIMDLane::I16x8:
+    case SIMDLane::I32x4:
+        return I32;
+    case SIMDLane::I64x2:
+        return I64;
+    case SIMDLane::F32x4:
+        return F32;
+    case SIMDLane::F64x2:
+        return F64;
+    case SIMDLane::V128:
+        break;
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+    return Void;
+}
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2018 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmStreamingCompiler.h"
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "WasmBBQPlan.h"
+#include "WasmCodeBlock.h"
+#include "WasmModuleInformation.h"
+#include "WasmWorklist.h"
+
+namespace JSC { namespace Wasm {
+
+StreamingCompiler::StreamingCompiler(Context* context, MemoryMode mode, CreateEmbedderWrapper&& createEmbedderWrapper, ThrowWasmException throwWasmException)
+    : m_context(context)
+    , m_mode(mode)
+    , m_createEmbedderWrapper(WTFMove(createEmbedderWrapper))
+    , m_throwWasmException(throwWasmException)
+    , m_parser(this)
+{
+}
+
+StreamingCompiler::~StreamingCompiler()
+{
+    // The module never finished arriving. Stop the worklist from compiling what it has.
+    if (m_plan)
+        failPlan("WebAssembly module streaming was abandoned"_s);
+}
+
+StreamingParser::State StreamingCompiler::addBytes(const uint8_t* bytes, size_t length)
+{
+    auto state = m_parser.addBytes(bytes, length);
+    if (state == StreamingParser::State::FatalError && m_plan)
+        failPlan(String(m_parser.errorMessage()));
+    return state;
+}
+
+void StreamingCompiler::failPlan(String&& errorMessage)
+{
+    // Returns once no compilation thread is reading function bodies out of the parser's buffer.
+    m_plan.releaseNonNull()->didFailStreaming(WTFMove(errorMessage));
+}
+
+void StreamingCompiler::didParseSectionsBeforeCode(ModuleInformation& moduleInformation)
+{
+    ASSERT(!m_plan);
+    m_plan = adoptRef(*new BBQPlan(m_context, makeRef(moduleInformation), BBQPlan::StreamingCompile, Plan::dontFinalize(), WTFMove(m_createEmbedderWrapper), m_throwWasmException));
+    m_plan->setMode(m_mode);
+    ensureWorklist().enqueue(makeRef(*m_plan));
+}
+
+void StreamingCompiler::didValidateFunction(uint32_t functionIndex, const uint8_t* functionStart, size_t functionLength)
+{
+    m_plan->addStreamedFunction(functionIndex, functionStart, functionLength);
+}
+
+void StreamingCompiler::didReleaseBuffer(Vector<uint8_t>&& buffer)
+{
+    m_plan->retainStreamedBytes(WTFMove(buffer));
+}
+
+auto StreamingCompiler::finalize() -> Result
+{
+    auto parseResult = m_parser.finalize();
+    if (!parseResult) {
+        if (m_plan)
+            failPlan(String(parseResult.error()));
+        return makeUnexpected(WTFMove(parseResult.error()));
+    }
+
+    Ref<Module> module = Module::create(WTFMove(*parseResult));
+    // Without a Code section there was nothing to compile ahead of time; the module compiles the
+    // usual way when it is instantiated.
+    if (!m_plan)
+        return Result(WTFMove(module));
+
+    ModuleInformation& moduleInformation = const_cast<ModuleInformation&>(module->moduleInformation());
+    Ref<BBQPlan> plan = m_plan.releaseNonNull();
+    plan->didFinishStreaming(makeRef(moduleInformation));
+    module->adoptCodeBlock(CodeBlock::create(m_context, m_mode, moduleInformation, WTFMove(plan)));
+    return Result(WTFMove(module));
+}
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
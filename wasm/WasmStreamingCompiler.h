@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2018 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "WasmEmbedder.h"
+#include "WasmModule.h"
+#include "WasmStreamingParser.h"
+#include <wtf/Expected.h>
+#include <wtf/RefPtr.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC { namespace Wasm {
+
+class BBQPlan;
+struct Context;
+
+// StreamingCompiler BBQ compiles a module while its bytes are still arriving. The plan starts once
+// the sections preceding Code have been parsed, and compiles each function as soon as
+// StreamingParser has validated it, so that little compilation is left once the last byte is in.
+class StreamingCompiler final : public StreamingParserClient {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    using Result = Expected<Ref<Module>, String>;
+
+    JS_EXPORT_PRIVATE StreamingCompiler(Context*, MemoryMode, CreateEmbedderWrapper&&, ThrowWasmException);
+    JS_EXPORT_PRIVATE ~StreamingCompiler();
+
+    JS_EXPORT_PRIVATE StreamingParser::State addBytes(const uint8_t*, size_t);
+
+    // Called once all bytes have been added. On success, the module's CodeBlock for this
+    // compiler's memory mode is the one compiled while streaming. It may still be compiling the
+    // last functions; use CodeBlock::waitUntilFinished() or compileAsync() to wait for it.
+    JS_EXPORT_PRIVATE Result finalize();
+
+private:
+    void didParseSectionsBeforeCode(ModuleInformation&) override;
+    void didValidateFunction(uint32_t functionIndex, const uint8_t*, size_t) override;
+    void didReleaseBuffer(Vector<uint8_t>&&) override;
+
+    void failPlan(String&&);
+
+    Context* m_context;
+    MemoryMode m_mode;
+    CreateEmbedderWrapper m_createEmbedderWrapper;
+    ThrowWasmException m_throwWasmException;
+    RefPtr<BBQPlan> m_plan;
+    StreamingParser m_parser;
+};
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
@@ -0,0 +1,329 @@
+/*
+ * Copyright (C) 2018 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmStreamingParser.h"
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "WasmModuleParser.h"
+#include "WasmOps.h"
+#include "WasmParser.h"
+#include "WasmValidate.h"
+#include <wtf/LEBDecoder.h>
+#include <wtf/text/StringConcatenateNumbers.h>
+
+namespace JSC { namespace Wasm {
+
+namespace WasmStreamingParserInternal {
+static const bool verbose = false;
+static const size_t moduleHeaderSize = 8;
+static const size_t maxVarUInt32Size = 5;
+}
+
+StreamingParser::StreamingParser(StreamingParserClient* client)
+    : m_client(client)
+    , m_info(adoptRef(*new ModuleInformation(Vector<uint8_t>())))
+{
+}
+
+template <typename ...Args>
+NEVER_INLINE auto StreamingParser::fail(Args... args) -> State
+{
+    using namespace FailureHelper; // See ADL comment in WasmParser.h.
+    m_errorMessage = makeString("WebAssembly.Module doesn't parse at byte "_s, String::number(m_offset), ": "_s, makeString(args)...);
+    return State::FatalError;
+}
+
+auto StreamingParser::decodeVarUInt32(uint32_t& result) -> LEBStatus
+{
+    size_t offset = m_offset;
+    if (WTF::LEBDecoder::decodeUInt32(m_buffer.data(), m_buffer.size(), offset, result)) {
+        m_offset = offset;
+        return LEBStatus::Decoded;
+    }
+    // The decoder only fails on a complete encoding when it is longer than a uint32 allows.
+    if (remaining() >= WasmStreamingParserInternal::maxVarUInt32Size)
+        return LEBStatus::Invalid;
+    return LEBStatus::NeedsMoreBytes;
+}
+
+auto StreamingParser::parseModuleHeader() -> State
+{
+    if (remaining() < WasmStreamingParserInternal::moduleHeaderSize)
+        return State::ModuleHeader;
+
+    const uint8_t* header = m_buffer.data() + m_offset;
+    if (header[0] || header[1] != 'a' || header[2] != 's' || header[3] != 'm')
+        return fail("modules doesn't start with '\\0asm'");
+    uint32_t versionNumber = header[4] | (header[5] << 8) | (header[6] << 16) | (static_cast<uint32_t>(header[7]) << 24);
+    if (versionNumber != expectedVersionNumber)
+        return fail("unexpected version number ", versionNumber, " expected ", expectedVersionNumber);
+
+    m_offset += WasmStreamingParserInternal::moduleHeaderSize;
+    return State::SectionID;
+}
+
+auto StreamingParser::parseSectionID() -> State
+{
+    if (!remaining())
+        return State::SectionID;
+
+    uint8_t sectionByte = m_buffer[m_offset];
+    if (sectionByte & 0x80)
+        return fail("can't get section byte");
+    Section section = Section::Custom;
+    if (!decodeSection(sectionByte, section))
+        return fail("invalid section byte ", sectionByte);
+    if (!validateOrder(m_previousKnownSection, section))
+        return fail("invalid section order, ", m_previousKnownSection, " followed by ", section);
+
+    m_section = section;
+    m_sectionStart = m_offset++;
+    return State::SectionSize;
+}
+
+auto StreamingParser::parseSectionSize() -> State
+{
+    uint32_t sectionLength;
+    switch (decodeVarUInt32(sectionLength)) {
+    case LEBStatus::NeedsMoreBytes:
+        return State::SectionSize;
+    case LEBStatus::Invalid:
+        return fail("can't get ", m_section, " section's length");
+    case LEBStatus::Decoded:
+        break;
+    }
+    if (sectionLength > maxModuleSize - m_offset)
+        return fail(m_section, " section of size ", sectionLength, " would overflow the maximum module size ", maxModuleSize);
+    m_sectionEnd = m_offset + sectionLength;
+
+    if (m_section != Section::Code)
+        return State::SectionPayload;
+
+    // Everything function validation depends on precedes the Code section, and is complete now.
+    ModuleParser moduleParser(m_buffer.data(), m_sectionStart, *m_info);
+    auto parseResult = moduleParser.parse();
+    if (!parseResult) {
+        m_errorMessage = WTFMove(parseResult.error());
+        return State::FatalError;
+    }
+    m_functionCount = m_info->functionLocationInBinary.size();
+    if (m_client) {
+        // Function bodies are handed to the client in place, so avoid moving the buffer while the
+        // Code section arrives. The declared size is untrusted; if it can't be reserved, the
+        // buffer is handed over when it grows instead.
+        m_buffer.tryReserveCapacity(m_sectionEnd);
+        m_client->didParseSectionsBeforeCode(*m_info);
+    }
+    return State::CodeSectionCount;
+}
+
+auto StreamingParser::parseSectionPayload() -> State
+{
+    if (m_buffer.size() < m_sectionEnd)
+        return State::SectionPayload;
+
+    // The contents of this section are checked by ModuleParser, either when the Code section
+    // begins or in finalize().
+    m_offset = m_sectionEnd;
+    if (isKnownSection(m_section))
+        m_previousKnownSection = m_section;
+    return State::SectionID;
+}
+
+auto StreamingParser::parseCodeSectionCount() -> State
+{
+    uint32_t count;
+    switch (decodeVarUInt32(count)) {
+    case LEBStatus::NeedsMoreBytes:
+        return State::CodeSectionCount;
+    case LEBStatus::Invalid:
+        return fail("can't get Code section's count");
+    case LEBStatus::Decoded:
+        break;
+    }
+    if (m_offset > m_sectionEnd)
+        return fail("Code section's count exceeds the section's size");
+    if (count != m_functionCount)
+        return fail("Code section count ", count, " does not match the declared number of functions ", m_functionCount);
+
+    if (count)
+        return State::FunctionSize;
+    m_previousKnownSection = Section::Code;
+    return State::SectionID;
+}
+
+auto StreamingParser::parseFunctionSize() -> State
+{
+    switch (decodeVarUInt32(m_functionSize)) {
+    case LEBStatus::NeedsMoreBytes:
+        return State::FunctionSize;
+    case LEBStatus::Invalid:
+        return fail("can't get ", m_functionIndex, "th Code function's size");
+    case LEBStatus::Decoded:
+        break;
+    }
+    if (m_functionSize > maxFunctionSize)
+        return fail("Code function's size ", m_functionSize, " is too big");
+    if (m_offset > m_sectionEnd || m_functionSize > m_sectionEnd - m_offset)
+        return fail("Code function's size ", m_functionSize, " exceeds the Code section's remaining size ", m_sectionEnd - std::min(m_offset, m_sectionEnd));
+    return State::FunctionPayload;
+}
+
+auto StreamingParser::parseFunctionPayload() -> State
+{
+    if (remaining() < m_functionSize)
+        return State::FunctionPayload;
+
+    const uint8_t* functionStart = m_buffer.data() + m_offset;
+    const Signature& signature = SignatureInformation::get(m_info->internalFunctionSignatureIndices[m_functionIndex]);
+    dataLogLnIf(WasmStreamingParserInternal::verbose, "Validating function ", m_functionIndex, " at ", m_offset, " of size ", m_functionSize);
+    auto validationResult = validateFunction(functionStart, m_functionSize, signature, *m_info);
+    if (!validationResult) {
+        m_errorMessage = makeString(validationResult.error(), ", in function at index ", String::number(m_functionIndex));
+        return State::FatalError;
+    }
+    if (m_client) {
+        m_client->didValidateFunction(m_functionIndex, functionStart, m_functionSize);
+        m_clientHoldsBuffer = true;
+    }
+
+    m_offset += m_functionSize;
+    if (++m_functionIndex < m_functionCount)
+        return State::FunctionSize;
+
+    if (m_offset != m_sectionEnd)
+        return fail("parsing ended before the end of Code section");
+    m_previousKnownSection = Section::Code;
+    return State::SectionID;
+}
+
+auto StreamingParser::addBytes(const uint8_t* bytes, size_t length) -> State
+{
+    if (m_state == State::FatalError || m_state == State::Finished)
+        return m_state;
+
+    if (length > maxModuleSize - m_buffer.size()) {
+        m_state = fail("module size ", m_buffer.size() + length, " is too large, maximum ", maxModuleSize);
+        return m_state;
+    }
+    if (m_clientHoldsBuffer && length > m_buffer.capacity() - m_buffer.size()) {
+        // Growing in place would free the storage the client's function bodies point into.
+        Vector<uint8_t> buffer;
+        buffer.reserveInitialCapacity(std::max(m_buffer.size() + length, m_buffer.capacity() * 2));
+        buffer.append(m_buffer.data(), m_buffer.size());
+        std::swap(buffer, m_buffer);
+        m_client->didReleaseBuffer(WTFMove(buffer));
+        m_clientHoldsBuffer = false;
+    }
+    m_buffer.append(bytes, length);
+
+    while (true) {
+        State previousState = m_state;
+        size_t previousOffset = m_offset;
+
+        switch (m_state) {
+        case State::ModuleHeader:
+            m_state = parseModuleHeader();
+            break;
+        case State::SectionID:
+            m_state = parseSectionID();
+            break;
+        case State::SectionSize:
+            m_state = parseSectionSize();
+            break;
+        case State::SectionPayload:
+            m_state = parseSectionPayload();
+            break;
+        case State::CodeSectionCount:
+            m_state = parseCodeSectionCount();
+            break;
+        case State::FunctionSize:
+            m_state = parseFunctionSize();
+            break;
+        case State::FunctionPayload:
+            m_state = parseFunctionPayload();
+            break;
+        case State::Finished:
+        case State::FatalError:
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+
+        if (m_state == State::FatalError)
+            return m_state;
+        // Every state either consumes bytes or moves on; staying put means it is waiting for more.
+        if (m_state == previousState && m_offset == previousOffset)
+            return m_state;
+    }
+}
+
+auto StreamingParser::finalize() -> Result
+{
+    if (m_state == State::FatalError)
+        return makeUnexpected(m_errorMessage);
+    RELEASE_ASSERT(m_state != State::Finished);
+
+    bool endedBetweenSections = m_state == State::SectionID && m_offset == m_buffer.size();
+    uint32_t validatedFunctionCount = m_functionIndex;
+
+    Ref<ModuleInformation> info = adoptRef(*new ModuleInformation(WTFMove(m_buffer)));
+    // The client may still be reading function bodies out of the buffer if finalizing fails.
+    m_info = info.copyRef();
+    {
+        ModuleParser moduleParser(info->source.data(), info->source.size(), info);
+        auto parseResult = moduleParser.parse();
+        if (!parseResult) {
+            m_state = State::FatalError;
+            m_errorMessage = WTFMove(parseResult.error());
+            return makeUnexpected(m_errorMessage);
+        }
+    }
+    if (!endedBetweenSections) {
+        m_state = fail("module ended before the end of its last section");
+        return makeUnexpected(m_errorMessage);
+    }
+
+    // Functions only remain here when the module declared them without a Code section.
+    const auto& functionLocations = info->functionLocationInBinary;
+    for (uint32_t functionIndex = validatedFunctionCount; functionIndex < functionLocations.size(); ++functionIndex) {
+        const uint8_t* functionStart = info->source.data() + functionLocations[functionIndex].start;
+        size_t functionLength = functionLocations[functionIndex].end - functionLocations[functionIndex].start;
+        const Signature& signature = SignatureInformation::get(info->internalFunctionSignatureIndices[functionIndex]);
+        auto validationResult = validateFunction(functionStart, functionLength, signature, info.get());
+        if (!validationResult) {
+            m_state = State::FatalError;
+            m_errorMessage = makeString(validationResult.error(), ", in function at index ", String::number(functionIndex));
+            return makeUnexpected(m_errorMessage);
+        }
+    }
+
+    m_state = State::Finished;
+    return Result(WTFMove(info));
+}
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
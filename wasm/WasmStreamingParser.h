@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2018 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "WasmModuleInformation.h"
+#include "WasmSections.h"
+#include <wtf/Expected.h>
+#include <wtf/Vector.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC { namespace Wasm {
+
+// Hears about the parts of a module as StreamingParser validates them, so that work such as
+// compilation can start before the last byte arrives.
+class StreamingParserClient {
+public:
+    virtual ~StreamingParserClient() { }
+
+    // The information is not modified after this call. The client may keep a reference to it.
+    virtual void didParseSectionsBeforeCode(ModuleInformation&) { }
+    // The bytes point into the parser's buffer. They stay valid until the parser is destroyed, or
+    // until it hands the buffer to didReleaseBuffer() or to the ModuleInformation finalize() returns.
+    virtual void didValidateFunction(uint32_t /* functionIndex */, const uint8_t*, size_t) { }
+    // Called when the buffer has to grow, with the storage earlier function bodies point into.
+    virtual void didReleaseBuffer(Vector<uint8_t>&&) { }
+};
+
+// StreamingParser consumes a module's bytes as they arrive and validates each function body as
+// soon as all of its bytes are available, so that validation overlaps with the transfer instead of
+// starting once the last byte is in. Sections before Code are parsed once the Code section begins,
+// because function validation needs their signatures, globals, and memory.
+class StreamingParser {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    enum class State : uint8_t {
+        ModuleHeader,
+        SectionID,
+        SectionSize,
+        SectionPayload,
+        CodeSectionCount,
+        FunctionSize,
+        FunctionPayload,
+        Finished,
+        FatalError
+    };
+
+    using Result = Expected<Ref<ModuleInformation>, String>;
+
+    JS_EXPORT_PRIVATE explicit StreamingParser(StreamingParserClient* = nullptr);
+
+    JS_EXPORT_PRIVATE State addBytes(const uint8_t*, size_t);
+
+    // Called once all bytes have been added. On success, returns module information whose
+    // functions have all been validated, so it can be handed straight to Module::create().
+    JS_EXPORT_PRIVATE Result finalize();
+
+    State state() const { return m_state; }
+    const String& errorMessage() const { return m_errorMessage; }
+    uint32_t validatedFunctionCount() const { return m_functionIndex; }
+
+private:
+    enum class LEBStatus : uint8_t { Decoded, NeedsMoreBytes, Invalid };
+    LEBStatus decodeVarUInt32(uint32_t&);
+
+    State parseModuleHeader();
+    State parseSectionID();
+    State parseSectionSize();
+    State parseSectionPayload();
+    State parseCodeSectionCount();
+    State parseFunctionSize();
+    State parseFunctionPayload();
+
+    template <typename ...Args>
+    NEVER_INLINE State WARN_UNUSED_RETURN fail(Args...);
+
+    size_t remaining() const { return m_buffer.size() - m_offset; }
+
+    StreamingParserClient* m_client;
+
+    Vector<uint8_t> m_buffer;
+    size_t m_offset { 0 };
+
+    // Module information for the sections preceding Code. It has no source of its own; finalize()
+    // parses the complete module into the ModuleInformation that is returned, and keeps it here
+    // along with the buffer it took over.
+    RefPtr<ModuleInformation> m_info;
+
+    Section m_previousKnownSection { Section::Begin };
+    Section m_section { Section::Begin };
+    size_t m_sectionStart { 0 };
+    size_t m_sectionEnd { 0 };
+    uint32_t m_functionCount { 0 };
+    uint32_t m_functionIndex { 0 };
+    uint32_t m_functionSize { 0 };
+    bool m_clientHoldsBuffer { false };
+
+    State m_state { State::ModuleHeader };
+    String m_errorMessage;
+};
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
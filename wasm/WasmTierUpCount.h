@@ -27,12 +27,59 @@
 
 #if ENABLE(WEBASSEMBLY)
 
+#include "B3Type.h"
+#include "B3ValueRep.h"
 #include "Options.h"
+#include "RegisterAtOffsetList.h"
 #include <wtf/Atomics.h>
 #include <wtf/StdLibExtras.h>
+#include <wtf/Vector.h>
 
 namespace JSC { namespace Wasm {
 
+class OSREntryValue : public B3::ValueRep {
+public:
+    OSREntryValue(const B3::ValueRep& valueRep, B3::Type type)
+        : B3::ValueRep(valueRep)
+        , m_type(type)
+    {
+    }
+
+    B3::Type type() const { return m_type; }
+
+private:
+    B3::Type m_type;
+};
+
+// Describes where a BBQ loop tier-up check keeps the function's locals, so that the check can
+// transfer them to OMG code compiled to enter the function at that loop.
+class OSREntryData {
+    WTF_MAKE_NONCOPYABLE(OSREntryData);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    OSREntryData(uint32_t functionIndex, uint32_t loopIndex, GPRReg instanceGPR, Vector<OSREntryValue>&& values, RegisterAtOffsetList&& calleeSaveRegisters)
+        : m_functionIndex(functionIndex)
+        , m_loopIndex(loopIndex)
+        , m_instanceGPR(instanceGPR)
+        , m_values(WTFMove(values))
+        , m_calleeSaveRegisters(WTFMove(calleeSaveRegisters))
+    {
+    }
+
+    uint32_t functionIndex() const { return m_functionIndex; }
+    uint32_t loopIndex() const { return m_loopIndex; }
+    GPRReg instanceGPR() const { return m_instanceGPR; }
+    const Vector<OSREntryValue>& values() const { return m_values; }
+    const RegisterAtOffsetList& calleeSaveRegisters() const { return m_calleeSaveRegisters; }
+
+private:
+    uint32_t m_functionIndex;
+    uint32_t m_loopIndex;
+    GPRReg m_instanceGPR;
+    Vector<OSREntryValue> m_values;
+    RegisterAtOffsetList m_calleeSaveRegisters;
+};
+
 // This class manages the tier up counts for Wasm binaries. The main interesting thing about
 // wasm tiering up counts is that the least significant bit indicates if the tier up has already
 // started. Also, wasm code does not atomically update this count. This is because we
@@ -51,6 +98,7 @@ public:
     {
         ASSERT(other.m_count == Options::webAssemblyOMGTierUpCount());
         m_count = other.m_count;
+        m_osrEntryData = WTFMove(other.m_osrEntryData);
     }
 
     static uint32_t loopDecrement() { return Options::webAssemblyLoopDecrement(); }
@@ -61,11 +109,34 @@ public:
         return !m_tierUpStarted.exchange(true);
     }
 
+    // Only one OSR entry compile is started per function, for the first loop that asks for one.
+    bool shouldStartOSREntryCompile(uint32_t loopIndex)
+    {
+        if (m_osrEntryCompileStarted.exchange(true))
+            return false;
+        m_osrEntryLoopIndex = loopIndex;
+        return true;
+    }
+    uint32_t osrEntryLoopIndex() const { return m_osrEntryLoopIndex; }
+
+    // Makes the next few loop iterations check again whether the OSR entry code is ready.
+    void checkOSREntrySoon() { m_count = Options::webAssemblyOMGTierUpCount(); }
+
+    // Called while BBQ generates the function's code, so the entries are never touched concurrently.
+    OSREntryData& addOSREntryData(uint32_t functionIndex, uint32_t loopIndex, GPRReg instanceGPR, Vector<OSREntryValue>&& values, RegisterAtOffsetList&& calleeSaveRegisters)
+    {
+        m_osrEntryData.append(std::make_unique<OSREntryData>(functionIndex, loopIndex, instanceGPR, WTFMove(values), WTFMove(calleeSaveRegisters)));
+        return *m_osrEntryData.last();
+    }
+
     int32_t count() { return bitwise_cast<int32_t>(m_count); }
 
 private:
     uint32_t m_count;
     Atomic<bool> m_tierUpStarted;
+    Atomic<bool> m_osrEntryCompileStarted { false };
+    uint32_t m_osrEntryLoopIndex { UINT32_MAX };
+    Vector<std::unique_ptr<OSREntryData>> m_osrEntryData;
 };
     
 } } // namespace JSC::Wasm
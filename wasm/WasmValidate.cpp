@@ -119,6 +119,26 @@ public:
     Result WARN_UNUSED_RETURN addOp(ExpressionType left, ExpressionType right, ExpressionType& result);
     Result WARN_UNUSED_RETURN addSelect(ExpressionType condition, ExpressionType nonZero, ExpressionType zero, ExpressionType& result);
 
+    // SIMD
+    Result WARN_UNUSED_RETURN addSIMDLoad(ExpressionType pointer, uint32_t offset, ExpressionType& result);
+    Result WARN_UNUSED_RETURN addSIMDStore(ExpressionType pointer, ExpressionType value, uint32_t offset);
+    ExpressionType addSIMDConstant(const v128_t&) { return V128; }
+    Result WARN_UNUSED_RETURN addSIMDShuffle(const v128_t& laneIndices, ExpressionType left, ExpressionType right, ExpressionType& result);
+    Result WARN_UNUSED_RETURN addSIMDExtractLane(SIMDOpType, uint8_t laneIndex, ExpressionType vector, ExpressionType& result);
+    Result WARN_UNUSED_RETURN addSIMDReplaceLane(SIMDOpType, uint8_t laneIndex, ExpressionType vector, ExpressionType scalar, ExpressionType& result);
+    Result WARN_UNUSED_RETURN addSIMDUnary(SIMDOpType, ExpressionType value, ExpressionType& result);
+    Result WARN_UNUSED_RETURN addSIMDBinary(SIMDOpType, ExpressionType left, ExpressionType right, ExpressionType& result);
+    Result WARN_UNUSED_RETURN addSIMDBitSelect(ExpressionType left, ExpressionType right, ExpressionType mask, ExpressionType& result);
+
+    // Atomics
+    Result WARN_UNUSED_RETURN addAtomicLoad(AtomicOpType, ExpressionType pointer, uint32_t offset, ExpressionType& result);
+    Result WARN_UNUSED_RETURN addAtomicStore(AtomicOpType, ExpressionType pointer, ExpressionType value, uint32_t offset);
+    Result WARN_UNUSED_RETURN addAtomicBinaryRMW(AtomicOpType, ExpressionType pointer, ExpressionType value, uint32_t offset, ExpressionType& result);
+    Result WARN_UNUSED_RETURN addAtomicCompareExchange(AtomicOpType, ExpressionType pointer, ExpressionType expected, ExpressionType replacement, uint32_t offset, ExpressionType& result);
+    Result WARN_UNUSED_RETURN addAtomicWait(AtomicOpType, ExpressionType pointer, ExpressionType expected, ExpressionType timeout, uint32_t offset, ExpressionType& result);
+    Result WARN_UNUSED_RETURN addAtomicNotify(ExpressionType pointer, ExpressionType count, uint32_t offset, ExpressionType& result);
+    Result WARN_UNUSED_RETURN addAtomicFence() { return { }; }
+
     // Control flow
     ControlData WARN_UNUSED_RETURN addTopLevel(Type signature);
     ControlData WARN_UNUSED_RETURN addBlock(Type signature);
@@ -134,6 +154,8 @@ public:
     Result WARN_UNUSED_RETURN addEndToUnreachable(ControlEntry&);
     Result WARN_UNUSED_RETURN addGrowMemory(ExpressionType delta, ExpressionType& result);
     Result WARN_UNUSED_RETURN addCurrentMemory(ExpressionType& result);
+    Result WARN_UNUSED_RETURN addMemoryCopy(ExpressionType destination, ExpressionType source, ExpressionType count);
+    Result WARN_UNUSED_RETURN addMemoryFill(ExpressionType destination, ExpressionType value, ExpressionType count);
 
     Result WARN_UNUSED_RETURN addUnreachable() { return { }; }
 
@@ -234,6 +256,86 @@ auto Validate::addSelect(ExpressionType condition, ExpressionType nonZero, Expre
     return { };
 }
 
+auto Validate::addSIMDLoad(ExpressionType pointer, uint32_t, ExpressionType& result) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(!hasMemory(), "v128.load instruction without memory");
+    WASM_VALIDATOR_FAIL_IF(pointer != I32, "v128.load pointer type mismatch");
+    result = V128;
+    return { };
+}
+
+auto Validate::addSIMDStore(ExpressionType pointer, ExpressionType value, uint32_t) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(!hasMemory(), "v128.store instruction without memory");
+    WASM_VALIDATOR_FAIL_IF(pointer != I32, "v128.store pointer type mismatch");
+    WASM_VALIDATOR_FAIL_IF(value != V128, "v128.store value type mismatch");
+    return { };
+}
+
+auto Validate::addSIMDShuffle(const v128_t&, ExpressionType left, ExpressionType right, ExpressionType& result) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(left != V128, "i8x16.shuffle left value type mismatch");
+    WASM_VALIDATOR_FAIL_IF(right != V128, "i8x16.shuffle right value type mismatch");
+    result = V128;
+    return { };
+}
+
+auto Validate::addSIMDExtractLane(SIMDOpType op, uint8_t, ExpressionType vector, ExpressionType& result) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(vector != V128, makeString(op), " vector type mismatch");
+    result = laneScalarType(simdLane(op));
+    return { };
+}
+
+auto Validate::addSIMDReplaceLane(SIMDOpType op, uint8_t, ExpressionType vector, ExpressionType scalar, ExpressionType& result) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(vector != V128, makeString(op), " vector type mismatch");
+    WASM_VALIDATOR_FAIL_IF(scalar != laneScalarType(simdLane(op)), makeString(op), " scalar type mismatch, got ", scalar, ", expected ", laneScalarType(simdLane(op)));
+    result = V128;
+    return { };
+}
+
+auto Validate::addSIMDUnary(SIMDOpType op, ExpressionType value, ExpressionType& result) -> Result
+{
+    switch (simdCategory(op)) {
+    case SIMDOpCategory::Splat:
+        WASM_VALIDATOR_FAIL_IF(value != laneScalarType(simdLane(op)), makeString(op), " value type mismatch, got ", value, ", expected ", laneScalarType(simdLane(op)));
+        result = V128;
+        return { };
+    case SIMDOpCategory::Unary:
+        WASM_VALIDATOR_FAIL_IF(value != V128, makeString(op), " value type mismatch");
+        result = V128;
+        return { };
+    case SIMDOpCategory::Reduce:
+        WASM_VALIDATOR_FAIL_IF(value != V128, makeString(op), " value type mismatch");
+        result = I32;
+        return { };
+    default:
+        break;
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+}
+
+auto Validate::addSIMDBinary(SIMDOpType op, ExpressionType left, ExpressionType right, ExpressionType& result) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(left != V128, makeString(op), " left value type mismatch");
+    if (simdCategory(op) == SIMDOpCategory::Shift)
+        WASM_VALIDATOR_FAIL_IF(right != I32, makeString(op), " shift count must be i32, got ", right);
+    else
+        WASM_VALIDATOR_FAIL_IF(right != V128, makeString(op), " right value type mismatch");
+    result = V128;
+    return { };
+}
+
+auto Validate::addSIMDBitSelect(ExpressionType left, ExpressionType right, ExpressionType mask, ExpressionType& result) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(left != V128, "v128.bitselect left value type mismatch");
+    WASM_VALIDATOR_FAIL_IF(right != V128, "v128.bitselect right value type mismatch");
+    WASM_VALIDATOR_FAIL_IF(mask != V128, "v128.bitselect mask type mismatch");
+    result = V128;
+    return { };
+}
+
 auto Validate::addIf(ExpressionType condition, Type signature, ControlType& result) -> Result
 {
     WASM_VALIDATOR_FAIL_IF(condition != I32, "if condition must be i32, got ", condition);
@@ -305,6 +407,70 @@ auto Validate::addCurrentMemory(ExpressionType& result) -> Result
     return { };
 }
 
+auto Validate::addMemoryCopy(ExpressionType destination, ExpressionType source, ExpressionType count) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(destination != I32, "memory.copy with non-i32 destination");
+    WASM_VALIDATOR_FAIL_IF(source != I32, "memory.copy with non-i32 source");
+    WASM_VALIDATOR_FAIL_IF(count != I32, "memory.copy with non-i32 count");
+    return { };
+}
+
+auto Validate::addMemoryFill(ExpressionType destination, ExpressionType value, ExpressionType count) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(destination != I32, "memory.fill with non-i32 destination");
+    WASM_VALIDATOR_FAIL_IF(value != I32, "memory.fill with non-i32 value");
+    WASM_VALIDATOR_FAIL_IF(count != I32, "memory.fill with non-i32 count");
+    return { };
+}
+
+auto Validate::addAtomicLoad(AtomicOpType op, ExpressionType pointer, uint32_t, ExpressionType& result) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(pointer != I32, makeString(op), " pointer type mismatch");
+    result = atomicValueType(op);
+    return { };
+}
+
+auto Validate::addAtomicStore(AtomicOpType op, ExpressionType pointer, ExpressionType value, uint32_t) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(pointer != I32, makeString(op), " pointer type mismatch");
+    WASM_VALIDATOR_FAIL_IF(value != atomicValueType(op), makeString(op), " value type mismatch, got ", value, ", expected ", atomicValueType(op));
+    return { };
+}
+
+auto Validate::addAtomicBinaryRMW(AtomicOpType op, ExpressionType pointer, ExpressionType value, uint32_t, ExpressionType& result) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(pointer != I32, makeString(op), " pointer type mismatch");
+    WASM_VALIDATOR_FAIL_IF(value != atomicValueType(op), makeString(op), " value type mismatch, got ", value, ", expected ", atomicValueType(op));
+    result = atomicValueType(op);
+    return { };
+}
+
+auto Validate::addAtomicCompareExchange(AtomicOpType op, ExpressionType pointer, ExpressionType expected, ExpressionType replacement, uint32_t, ExpressionType& result) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(pointer != I32, makeString(op), " pointer type mismatch");
+    WASM_VALIDATOR_FAIL_IF(expected != atomicValueType(op), makeString(op), " expected value type mismatch, got ", expected, ", expected ", atomicValueType(op));
+    WASM_VALIDATOR_FAIL_IF(replacement != atomicValueType(op), makeString(op), " replacement value type mismatch, got ", replacement, ", expected ", atomicValueType(op));
+    result = atomicValueType(op);
+    return { };
+}
+
+auto Validate::addAtomicWait(AtomicOpType op, ExpressionType pointer, ExpressionType expected, ExpressionType timeout, uint32_t, ExpressionType& result) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(pointer != I32, makeString(op), " pointer type mismatch");
+    WASM_VALIDATOR_FAIL_IF(expected != atomicValueType(op), makeString(op), " expected value type mismatch, got ", expected, ", expected ", atomicValueType(op));
+    WASM_VALIDATOR_FAIL_IF(timeout != I64, makeString(op), " timeout must be i64");
+    result = I32;
+    return { };
+}
+
+auto Validate::addAtomicNotify(ExpressionType pointer, ExpressionType count, uint32_t, ExpressionType& result) -> Result
+{
+    WASM_VALIDATOR_FAIL_IF(pointer != I32, "memory.atomic.notify pointer type mismatch");
+    WASM_VALIDATOR_FAIL_IF(count != I32, "memory.atomic.notify count must be i32");
+    result = I32;
+    return { };
+}
+
 auto Validate::endBlock(ControlEntry& entry, ExpressionList& stack) -> Result
 {
     WASM_FAIL_IF_HELPER_FAILS(unify(stack, entry.controlData));
@@ -157,6 +157,21 @@ void Worklist::enqueue(Ref<Plan> plan)
     m_planEnqueued->notifyOne(locker);
 }
 
+void Worklist::resume(Ref<Plan> plan)
+{
+    LockHolder locker(*m_lock);
+    ASSERT(plan->multiThreaded());
+
+    for (const auto& element : m_queue) {
+        if (element.plan.get() == &plan.get())
+            return;
+    }
+
+    dataLogLnIf(WasmWorklistInternal::verbose, "Resuming plan");
+    m_queue.enqueue({ Priority::Compilation, nextTicket(), WTFMove(plan) });
+    m_planEnqueued->notifyOne(locker);
+}
+
 void Worklist::completePlanSynchronously(Plan& plan)
 {
     {
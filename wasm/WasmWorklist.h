@@ -47,6 +47,9 @@ public:
     ~Worklist();
 
     JS_EXPORT_PRIVATE void enqueue(Ref<Plan>);
+    // Puts a prepared plan that ran out of work back in the queue, e.g. when a streaming plan
+    // receives more functions. Does nothing if the plan is still queued.
+    void resume(Ref<Plan>);
     void stopAllPlansForContext(Context&);
 
     JS_EXPORT_PRIVATE void completePlanSynchronously(Plan&);
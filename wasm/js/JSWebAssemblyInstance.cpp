@@ -36,6 +36,8 @@
 #include "JSWebAssemblyLinkError.h"
 #include "JSWebAssemblyMemory.h"
 #include "JSWebAssemblyModule.h"
+#include "ReleaseHeapAccessScope.h"
+#include "TypedArrayController.h"
 #include "WebAssemblyModuleRecord.h"
 #include "WebAssemblyToJSCallee.h"
 #include <wtf/StdLibExtras.h>
@@ -103,7 +105,9 @@ void JSWebAssemblyInstance::finalizeCreation(VM& vm, ExecState* exec, Ref<Wasm::
     }
 
     RELEASE_ASSERT(wasmCodeBlock->isSafeToRun(memoryMode()));
-    JSWebAssemblyCodeBlock* jsCodeBlock = m_module->codeBlock(memoryMode());
+    // The code may have been compiled for another memory mode than ours; see Wasm::Module::getOrCreateCodeBlock.
+    Wasm::MemoryMode codeMode = wasmCodeBlock->mode();
+    JSWebAssemblyCodeBlock* jsCodeBlock = m_module->codeBlock(codeMode);
     if (jsCodeBlock) {
         // A CodeBlock might have already been compiled. If so, it means
         // that the CodeBlock we are trying to compile must be the same
@@ -118,7 +122,7 @@ void JSWebAssemblyInstance::finalizeCreation(VM& vm, ExecState* exec, Ref<Wasm::
             return;
         }
         m_codeBlock.set(vm, this, jsCodeBlock);
-        m_module->setCodeBlock(vm, memoryMode(), jsCodeBlock);
+        m_module->setCodeBlock(vm, codeMode, jsCodeBlock);
     }
 
     for (unsigned importFunctionNum = 0; importFunctionNum < instance().numImportFunctions(); ++importFunctionNum) {
@@ -172,9 +176,18 @@ JSWebAssemblyInstance* JSWebAssemblyInstance::create(VM& vm, ExecState* exec, co
         vm.topCallFrame = bitwise_cast<ExecState*>(topCallFrame);
     };
 
+    // Like Atomics.wait, memory.atomic.wait lets the collector run while the thread is blocked.
+    auto wait = [&vm] (const ScopedLambda<void()>& block) {
+        if (!vm.m_typedArrayController->isAtomicsWaitAllowedOnCurrentThread())
+            return false;
+        ReleaseHeapAccessScope releaseHeapAccessScope(vm.heap);
+        block();
+        return true;
+    };
+
     // FIXME: These objects could be pretty big we should try to throw OOM here.
     auto* jsInstance = new (NotNull, allocateCell<JSWebAssemblyInstance>(vm.heap)) JSWebAssemblyInstance(vm, instanceStructure, 
-        Wasm::Instance::create(&vm.wasmContext, WTFMove(module), &vm.topEntryFrame, vm.addressOfSoftStackLimit(), WTFMove(storeTopCallFrame)));
+        Wasm::Instance::create(&vm.wasmContext, WTFMove(module), &vm.topEntryFrame, vm.addressOfSoftStackLimit(), WTFMove(storeTopCallFrame), WTFMove(wait)));
     jsInstance->finishCreation(vm, jsModule, moduleNamespace);
     RETURN_IF_EXCEPTION(throwScope, nullptr);
 
@@ -244,6 +257,11 @@ JSWebAssemblyInstance* JSWebAssemblyInstance::create(VM& vm, ExecState* exec, co
             if (!memory)
                 return exception(createJSWebAssemblyLinkError(exec, vm, importFailMessage(import, "Memory import", "is not an instance of WebAssembly.Memory")));
 
+            if (memory->memory().isShared() != moduleInformation.memory.isShared()) {
+                return exception(createJSWebAssemblyLinkError(exec, vm, importFailMessage(import, "Memory import",
+                    moduleInformation.memory.isShared() ? "is not shared but the module requires a shared memory" : "is shared but the module requires an unshared memory")));
+            }
+
             Wasm::PageCount declaredInitial = moduleInformation.memory.initial();
             Wasm::PageCount importedInitial = memory->memory().initial();
             if (importedInitial < declaredInitial)
@@ -281,10 +299,8 @@ JSWebAssemblyInstance* JSWebAssemblyInstance::create(VM& vm, ExecState* exec, co
             auto* jsMemory = JSWebAssemblyMemory::create(exec, vm, globalObject->WebAssemblyMemoryStructure());
             RETURN_IF_EXCEPTION(throwScope, nullptr);
 
-            RefPtr<Wasm::Memory> memory = Wasm::Memory::create(moduleInformation.memory.initial(), moduleInformation.memory.maximum(),
-                [&vm] (Wasm::Memory::NotifyPressure) { vm.heap.collectAsync(CollectionScope::Full); },
-                [&vm] (Wasm::Memory::SyncTryToReclaim) { vm.heap.collectSync(CollectionScope::Full); },
-                [&vm, jsMemory] (Wasm::Memory::GrowSuccess, Wasm::PageCount oldPageCount, Wasm::PageCount newPageCount) { jsMemory->growSuccessCallback(vm, oldPageCount, newPageCount); });
+            RefPtr<Wasm::Memory> memory = jsMemory->tryCreateMemory(vm, moduleInformation.memory.initial(), moduleInformation.memory.maximum(),
+                moduleInformation.memory.isShared() ? Wasm::MemorySharingMode::Shared : Wasm::MemorySharingMode::Default);
             if (!memory)
                 return exception(createOutOfMemoryError(exec));
 
@@ -55,10 +55,28 @@ JSWebAssemblyMemory* JSWebAssemblyMemory::create(ExecState* exec, VM& vm, Struct
     return memory;
 }
     
+// Any agent that can see a shared memory may grow it, so a shared memory's callbacks can't touch this
+// VM. Instead, buffer() notices the new size, and visitChildren() reports it.
+RefPtr<Wasm::Memory> JSWebAssemblyMemory::tryCreateMemory(VM& vm, Wasm::PageCount initial, Wasm::PageCount maximum, Wasm::MemorySharingMode sharingMode)
+{
+    if (sharingMode == Wasm::MemorySharingMode::Shared) {
+        return Wasm::Memory::create(initial, maximum, sharingMode,
+            [] (Wasm::Memory::NotifyPressure) { },
+            [] (Wasm::Memory::SyncTryToReclaim) { },
+            [] (Wasm::Memory::GrowSuccess, Wasm::PageCount, Wasm::PageCount) { });
+    }
+
+    return Wasm::Memory::create(initial, maximum, sharingMode,
+        [&vm] (Wasm::Memory::NotifyPressure) { vm.heap.collectAsync(CollectionScope::Full); },
+        [&vm] (Wasm::Memory::SyncTryToReclaim) { vm.heap.collectSync(CollectionScope::Full); },
+        [&vm, this] (Wasm::Memory::GrowSuccess, Wasm::PageCount oldPageCount, Wasm::PageCount newPageCount) { growSuccessCallback(vm, oldPageCount, newPageCount); });
+}
+
+// A shared memory may also come from another agent, which holds on to it too.
 void JSWebAssemblyMemory::adopt(Ref<Wasm::Memory>&& memory)
 {
     m_memory.swap(memory);
-    ASSERT(m_memory->refCount() == 1);
+    ASSERT(m_memory->refCount() == 1 || m_memory->isShared());
     m_memory->check();
 }
 
@@ -75,15 +93,24 @@ JSWebAssemblyMemory::JSWebAssemblyMemory(VM& vm, Structure* structure)
 
 JSArrayBuffer* JSWebAssemblyMemory::buffer(VM& vm, JSGlobalObject* globalObject)
 {
-    if (m_bufferWrapper)
-        return m_bufferWrapper.get();
+    if (m_bufferWrapper) {
+        // A shared memory grew, maybe through another agent. It never moves and other agents may
+        // be using the old buffer, so that one is left alone and we only stop handing it out.
+        if (m_buffer->byteLength() == memory().size())
+            return m_bufferWrapper.get();
+        ASSERT(memory().isShared());
+        m_buffer = nullptr;
+        m_bufferWrapper.clear();
+    }
 
     // We can't use a ref here since it doesn't have a copy constructor...
     Ref<Wasm::Memory> protectedMemory = m_memory.get();
     auto destructor = [protectedMemory = WTFMove(protectedMemory)] (void*) { };
     m_buffer = ArrayBuffer::createFromBytes(memory().memory(), memory().size(), WTFMove(destructor));
     m_buffer->makeWasmMemory();
-    m_bufferWrapper.set(vm, this, JSArrayBuffer::create(vm, globalObject->m_arrayBufferStructure.get(), m_buffer.get()));
+    if (memory().isShared())
+        m_buffer->makeShared();
+    m_bufferWrapper.set(vm, this, JSArrayBuffer::create(vm, globalObject->arrayBufferStructure(m_buffer->sharingMode()), m_buffer.get()));
     RELEASE_ASSERT(m_bufferWrapper);
     return m_bufferWrapper.get();
 }
@@ -117,7 +144,8 @@ Wasm::PageCount JSWebAssemblyMemory::grow(VM& vm, ExecState* exec, uint32_t delt
 void JSWebAssemblyMemory::growSuccessCallback(VM& vm, Wasm::PageCount oldPageCount, Wasm::PageCount newPageCount)
 {
     // We need to clear out the old array buffer because it might now be pointing to stale memory.
-    // Neuter the old array.
+    // Neuter the old array. Shared memories don't get here.
+    ASSERT(!memory().isShared());
     if (m_buffer) {
         m_buffer->neuter(vm);
         m_buffer = nullptr;
@@ -55,6 +55,7 @@ public:
 
     DECLARE_EXPORT_INFO;
 
+    RefPtr<Wasm::Memory> tryCreateMemory(VM&, Wasm::PageCount initial, Wasm::PageCount maximum, Wasm::MemorySharingMode);
     void adopt(Ref<Wasm::Memory>&&);
     Wasm::Memory& memory() { return m_memory.get(); }
     JSArrayBuffer* buffer(VM& vm, JSGlobalObject*);
@@ -56,8 +56,7 @@ static EncodedJSValue JSC_HOST_CALL callWebAssemblyFunction(ExecState* exec)
     WebAssemblyFunction* wasmFunction = jsDynamicCast<WebAssemblyFunction*>(vm, exec->jsCallee());
     if (!wasmFunction)
         return JSValue::encode(throwException(exec, scope, createTypeError(exec, "expected a WebAssembly function", defaultSourceAppender, runtimeTypeForValue(vm, exec->jsCallee()))));
-    Wasm::SignatureIndex signatureIndex = wasmFunction->signatureIndex();
-    const Wasm::Signature& signature = Wasm::SignatureInformation::get(signatureIndex);
+    const Wasm::Signature& signature = wasmFunction->signature();
 
     // Make sure that the memory we think we are going to run with matches the one we expect.
     ASSERT(wasmFunction->instance()->instance().codeBlock()->isSafeToRun(wasmFunction->instance()->memory()->memory().mode()));
@@ -83,7 +82,8 @@ static EncodedJSValue JSC_HOST_CALL callWebAssemblyFunction(ExecState* exec)
     if (Options::useTracePoints())
         traceScope.emplace(WebAssemblyExecuteStart, WebAssemblyExecuteEnd);
 
-    Vector<JSValue> boxedArgs;
+    // Most exports take a handful of arguments, so avoid allocating on every call.
+    Vector<JSValue, 8> boxedArgs;
     JSWebAssemblyInstance* instance = wasmFunction->instance();
     Wasm::Instance* wasmInstance = &instance->instance();
     // When we don't use fast TLS to store the context, the JS
@@ -107,6 +107,7 @@ static EncodedJSValue JSC_HOST_CALL callWebAssemblyFunction(ExecState* exec)
         case Wasm::I64:
         case Wasm::Func:
         case Wasm::Anyfunc:
+        case Wasm::V128:
             RELEASE_ASSERT_NOT_REACHED();
         }
         RETURN_IF_EXCEPTION(scope, encodedJSValue());
@@ -172,6 +173,7 @@ static EncodedJSValue JSC_HOST_CALL callWebAssemblyFunction(ExecState* exec)
     case Wasm::I64:
     case Wasm::Func:
     case Wasm::Anyfunc:
+    case Wasm::V128:
         RELEASE_ASSERT_NOT_REACHED();
     }
 
@@ -198,6 +200,7 @@ WebAssemblyFunction::WebAssemblyFunction(VM& vm, JSGlobalObject* globalObject, S
     : Base { vm, globalObject, structure }
     , m_jsEntrypoint { jsEntrypoint.entrypoint() }
     , m_importableFunction { signatureIndex, wasmToWasmEntrypointLoadLocation }
+    , m_signature { &Wasm::SignatureInformation::get(signatureIndex) }
 { }
 
 } // namespace JSC
@@ -61,6 +61,7 @@ public:
     static Structure* createStructure(VM&, JSGlobalObject*, JSValue);
 
     Wasm::SignatureIndex signatureIndex() const { return m_importableFunction.signatureIndex; }
+    const Wasm::Signature& signature() const { return *m_signature; }
     WasmToWasmImportableFunction::LoadLocation entrypointLoadLocation() const { return m_importableFunction.entrypointLoadLocation; }
     WasmToWasmImportableFunction importableFunction() const { return m_importableFunction; }
 
@@ -82,6 +83,8 @@ private:
     // ensures that the actual Signature/code doesn't get deallocated.
     MacroAssemblerCodePtr<WasmEntryPtrTag> m_jsEntrypoint;
     WasmToWasmImportableFunction m_importableFunction;
+    // Cached so that calls don't have to take SignatureInformation's lock to look it up.
+    const Wasm::Signature* m_signature;
 };
 
 } // namespace JSC
@@ -96,13 +96,21 @@ static EncodedJSValue JSC_HOST_CALL constructJSWebAssemblyMemory(ExecState* exec
         }
     }
 
+    Wasm::MemorySharingMode sharingMode = Wasm::MemorySharingMode::Default;
+    if (Options::useWebAssemblyThreads()) {
+        JSValue sharedValue = memoryDescriptor->get(exec, Identifier::fromString(&vm, "shared"));
+        RETURN_IF_EXCEPTION(throwScope, encodedJSValue());
+        if (sharedValue.toBoolean(exec)) {
+            if (!maximumPageCount)
+                return JSValue::encode(throwException(exec, throwScope, createTypeError(exec, "WebAssembly.Memory with 'shared' set must also have a 'maximum'"_s)));
+            sharingMode = Wasm::MemorySharingMode::Shared;
+        }
+    }
+
     auto* jsMemory = JSWebAssemblyMemory::create(exec, vm, exec->lexicalGlobalObject()->WebAssemblyMemoryStructure());
     RETURN_IF_EXCEPTION(throwScope, encodedJSValue());
 
-    RefPtr<Wasm::Memory> memory = Wasm::Memory::create(initialPageCount, maximumPageCount,
-        [&vm] (Wasm::Memory::NotifyPressure) { vm.heap.collectAsync(CollectionScope::Full); },
-        [&vm] (Wasm::Memory::SyncTryToReclaim) { vm.heap.collectSync(CollectionScope::Full); },
-        [&vm, jsMemory] (Wasm::Memory::GrowSuccess, Wasm::PageCount oldPageCount, Wasm::PageCount newPageCount) { jsMemory->growSuccessCallback(vm, oldPageCount, newPageCount); });
+    RefPtr<Wasm::Memory> memory = jsMemory->tryCreateMemory(vm, initialPageCount, maximumPageCount, sharingMode);
     if (!memory)
         return JSValue::encode(throwException(exec, throwScope, createOutOfMemoryError(exec)));
 
@@ -46,6 +46,7 @@
 #include "StrongInlines.h"
 #include "ThrowScope.h"
 #include "WasmBBQPlan.h"
+#include "WasmStreamingCompiler.h"
 #include "WasmToJS.h"
 #include "WasmWorklist.h"
 #include "WebAssemblyInstanceConstructor.h"
@@ -255,6 +256,48 @@ void WebAssemblyPrototype::webAssemblyModuleInstantinateAsync(ExecState* exec, J
     CLEAR_AND_RETURN_IF_EXCEPTION(catchScope, void());
 }
 
+std::unique_ptr<Wasm::StreamingCompiler> WebAssemblyPrototype::createStreamingCompiler(VM& vm)
+{
+    // The memory mode has to be picked before the imports are known. Instances that end up with
+    // a signaling memory compile the module again when they are created.
+    return std::make_unique<Wasm::StreamingCompiler>(&vm.wasmContext, Wasm::MemoryMode::BoundsChecking, &Wasm::createJSToWasmWrapper, &Wasm::wasmToJSException);
+}
+
+static JSWebAssemblyModule* finalizeStreamingCompiler(VM& vm, ExecState* exec, Wasm::StreamingCompiler& compiler)
+{
+    Wasm::Module::ValidationResult result;
+    auto compileResult = compiler.finalize();
+    if (compileResult)
+        result = Wasm::Module::ValidationResult(WTFMove(*compileResult));
+    else
+        result = makeUnexpected(WTFMove(compileResult.error()));
+    return JSWebAssemblyModule::createStub(vm, exec, exec->lexicalGlobalObject()->WebAssemblyModuleStructure(), WTFMove(result));
+}
+
+void WebAssemblyPrototype::webAssemblyModuleValidateStreaming(ExecState* exec, JSPromiseDeferred* promise, Wasm::StreamingCompiler& compiler)
+{
+    VM& vm = exec->vm();
+    auto scope = DECLARE_CATCH_SCOPE(vm);
+    JSWebAssemblyModule* module = finalizeStreamingCompiler(vm, exec, compiler);
+    if (UNLIKELY(scope.exception()))
+        return reject(exec, scope, promise);
+
+    promise->resolve(exec, module);
+    CLEAR_AND_RETURN_IF_EXCEPTION(scope, void());
+}
+
+void WebAssemblyPrototype::webAssemblyModuleInstantiateStreaming(ExecState* exec, JSPromiseDeferred* promise, Wasm::StreamingCompiler& compiler, JSObject* importObject)
+{
+    VM& vm = exec->vm();
+    auto scope = DECLARE_CATCH_SCOPE(vm);
+    JSWebAssemblyModule* module = finalizeStreamingCompiler(vm, exec, compiler);
+    if (UNLIKELY(scope.exception()))
+        return reject(exec, scope, promise);
+
+    // Qualified, since WebAssemblyPrototype::instantiate() hides the static function.
+    JSC::instantiate(vm, exec, promise, module, importObject, JSWebAssemblyInstance::createPrivateModuleKey(), Resolve::WithModuleAndInstance, Wasm::CreationMode::FromJS);
+}
+
 static EncodedJSValue JSC_HOST_CALL webAssemblyInstantiateFunc(ExecState* exec)
 {
     VM& vm = exec->vm();
@@ -315,7 +358,7 @@ EncodedJSValue JSC_HOST_CALL webAssemblyCompileStreamingInternal(ExecState* exec
     if (globalObject->globalObjectMethodTable()->compileStreaming)
         globalObject->globalObjectMethodTable()->compileStreaming(globalObject, exec, promise, exec->argument(0));
     else {
-        // CompileStreaming is not supported in jsc, only in browser environment
+        // The embedder does not support streaming compilation.
         ASSERT_NOT_REACHED();
     }
 
@@ -352,7 +395,7 @@ EncodedJSValue JSC_HOST_CALL webAssemblyInstantiateStreamingInternal(ExecState*
                 // FIXME: <http://webkit.org/b/184888> if there's an importObject and it contains a Memory, then we can compile the module with the right memory type (fast or not) by looking at the memory's type.
                 globalObject->globalObjectMethodTable()->instantiateStreaming(globalObject, exec, promise, exec->argument(0), importObject);
             } else {
-                // InstantiateStreaming is not supported in jsc, only in browser environment.
+                // The embedder does not support streaming compilation.
                 ASSERT_NOT_REACHED();
             }
         }
@@ -33,6 +33,10 @@
 
 namespace JSC {
 
+namespace Wasm {
+class StreamingCompiler;
+}
+
 class WebAssemblyPrototype final : public JSNonFinalObject {
 public:
     typedef JSNonFinalObject Base;
@@ -43,6 +47,12 @@ public:
     JS_EXPORT_PRIVATE static void webAssemblyModuleValidateAsync(ExecState*, JSPromiseDeferred*, Vector<uint8_t>&&);
     JS_EXPORT_PRIVATE static void webAssemblyModuleInstantinateAsync(ExecState*, JSPromiseDeferred*, Vector<uint8_t>&&, JSObject*);
 
+    // For the embedder's compileStreaming and instantiateStreaming hooks: feed the response's bytes
+    // to the compiler as they arrive, then settle the promise with one of the functions below.
+    JS_EXPORT_PRIVATE static std::unique_ptr<Wasm::StreamingCompiler> createStreamingCompiler(VM&);
+    JS_EXPORT_PRIVATE static void webAssemblyModuleValidateStreaming(ExecState*, JSPromiseDeferred*, Wasm::StreamingCompiler&);
+    JS_EXPORT_PRIVATE static void webAssemblyModuleInstantiateStreaming(ExecState*, JSPromiseDeferred*, Wasm::StreamingCompiler&, JSObject*);
+
     DECLARE_INFO;
 
     static JSValue instantiate(ExecState*, JSPromiseDeferred*, const Identifier&, JSValue);